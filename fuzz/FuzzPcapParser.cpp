@@ -0,0 +1,25 @@
+// libFuzzer / AFL harness for PcapParser: the input is a whole capture file.
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "PcapParser.h"
+
+// Small enough that the fuzzer reaches the resync path on tiny inputs.
+static constexpr size_t FUZZ_MAX_RESYNC_BYTES = 4096;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    auto input = std::make_unique<std::istringstream>(
+        std::string(reinterpret_cast<const char*>(data), size), std::ios::binary);
+    parser::PcapParser parser(std::move(input));
+    if (!parser.readGlobalHeader()) {
+        return 0;
+    }
+    parser.enableResync(FUZZ_MAX_RESYNC_BYTES);
+    for (std::vector<uint8_t> packetData; parser.readNextPacket(packetData); ) {
+    }
+    return 0;
+}
@@ -0,0 +1,15 @@
+// libFuzzer / AFL harness for SimbaDecoder: the input is one UDP payload.
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SimbaDecoder.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const std::vector<uint8_t> packetData(data, data + size);
+    simba::SimbaDecoder decoder(packetData);
+    if (decoder.Decode()) {
+        decoder.GetDecodedMessages().toJSON();
+    }
+    return 0;
+}
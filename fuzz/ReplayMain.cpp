@@ -0,0 +1,30 @@
+// Driver for building the fuzz harnesses without libFuzzer: runs the harness
+// once per file argument, or once on stdin when there are none (the mode AFL
+// uses with afl-g++ / afl-clang-fast++).
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static int runOne(std::istream& in) {
+    const std::vector<uint8_t> input((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return LLVMFuzzerTestOneInput(input.data(), input.size());
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        return runOne(std::cin);
+    }
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open " << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+        runOne(file);
+    }
+    return EXIT_SUCCESS;
+}
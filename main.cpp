@@ -2,85 +2,135 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
-#include <map>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
 #include <chrono>
-#include <future>
 #include <thread>
-#include "PcapParser.h"
-#include "SimbaDecoder.h"
+#include <memory>
+#include "Batch.h"
+#include "RecoveryEngine.h"
 #include "SafeVector.h"
 #include "ThreadPool.h"
 
-// More threads can lead to increased competition for the CPU cache. 
+// More threads can lead to increased competition for the CPU cache.
 // Because the working set size is large, running more threads might cause cache thrashing, which slows down execution.
 const unsigned int MAX_THREADS = 4;
-const unsigned int EXPECTED_NUMBER_OF_PACKETS = 50000;
+// Order book recovery runs on its own threads, one per shard of instruments.
+const unsigned int RECOVERY_SHARDS = 4;
 
-void writerThread(const std::string& outputFileName, SafeVector<std::future<std::string>> &futures) {
-    std::ofstream outFile(outputFileName);
-    if (!outFile.is_open()) {
-        std::cerr << "Error: Could not open output file." << std::endl;
-        return;
+// Malformed input is only counted on the hot path; report it once here.
+void reportErrors(const CaptureStats& stats) {
+    const auto& parserStats = stats.parser;
+    const auto& decodeErrors = stats.decodeErrors;
+    if (parserStats.malformed_packets || parserStats.corrupt_headers || parserStats.truncated) {
+        std::cerr << "Skipped " << parserStats.malformed_packets << " malformed packets, "
+                  << parserStats.corrupt_headers << " corrupt record headers ("
+                  << parserStats.resyncs << " resyncs, " << parserStats.skipped_bytes << " bytes skipped)"
+                  << (parserStats.truncated ? ", capture is truncated" : "") << std::endl;
     }
-    std::future<std::string> future;
-    while (true) {
-        if (!futures.pop(future))  {
-            break;
-        }
-        if (std::string jsonOutput = future.get(); !jsonOutput.empty()) {
-            outFile << jsonOutput << "\n";
-        }
+    using simba::DecodeStatus;
+    if (const uint64_t failed = decodeErrors[static_cast<size_t>(DecodeStatus::TruncatedPacketHeader)]
+            + decodeErrors[static_cast<size_t>(DecodeStatus::TruncatedMessageHeader)]
+            + decodeErrors[static_cast<size_t>(DecodeStatus::MalformedMessage)]; failed != 0) {
+        std::cerr << "Failed to decode " << failed << " packets ("
+                  << decodeErrors[static_cast<size_t>(DecodeStatus::TruncatedPacketHeader)] << " truncated packet headers, "
+                  << decodeErrors[static_cast<size_t>(DecodeStatus::TruncatedMessageHeader)] << " truncated message headers, "
+                  << decodeErrors[static_cast<size_t>(DecodeStatus::MalformedMessage)] << " malformed messages)" << std::endl;
     }
 }
 
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " <pcap file path> <output file path> [order books output path]\n"
+              << "       " << program << " --batch <output directory> <input>...\n"
+              << "       " << program << " --merge <output file path> <input>...\n"
+              << "  <input> is a pcap file, a directory of .pcap/.cap files, a quoted glob\n"
+              << "  such as 'captures/*.pcap', or @file listing one input per line.\n"
+              << "  --batch writes one <capture name>.json per input, prefixed with the parent\n"
+              << "  directory when names repeat; --merge writes a single output ordered by\n"
+              << "  capture timestamp and msg_seq_num." << std::endl;
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 3) {
-        std::cerr << "Usage: " << argv[0] << " <pcap file path> <output file path>" << std::endl;
+        printUsage(argv[0]);
         return EXIT_FAILURE;
     }
-    
+
+    const std::string mode = argv[1];
+    if (mode == "--batch" || mode == "--merge") {
+        if (argc < 4) {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        std::vector<std::string> inputs;
+        for (int i = 3; i < argc; ++i) {
+            if (!expandInputs(argv[i], inputs)) {
+                return EXIT_FAILURE;
+            }
+        }
+        if (inputs.empty()) {
+            std::cerr << "Error: No capture files found." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // Captures are independent, so batch runs size the pool to the machine
+        // rather than to the single-capture sweet spot of MAX_THREADS.
+        const unsigned int numThreads = std::max(1u, std::thread::hardware_concurrency());
+        const unsigned int maxConcurrentFiles = std::max(1u, numThreads / 2);
+
+        auto start = std::chrono::steady_clock::now();
+        const CaptureStats stats = mode == "--batch"
+            ? runBatch(argv[2], inputs, numThreads, maxConcurrentFiles)
+            : runMerge(argv[2], inputs, numThreads);
+        reportErrors(stats);
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "Processed " << inputs.size() << " captures in "
+                  << std::chrono::duration<double, std::milli>(end - start).count() / 1000
+                  << " seconds" << std::endl;
+        return stats.ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     const std::string pcapFileName = argv[1];
     const std::string outputFileName = argv[2];
-    
+    const std::string booksFileName = argc > 3 ? argv[3] : "";
+    const bool recoverBooks = !booksFileName.empty();
+
+    std::unique_ptr<simba::RecoveryEngine> recovery;
+    if (recoverBooks) {
+        recovery = std::make_unique<simba::RecoveryEngine>(RECOVERY_SHARDS);
+    }
+
     ThreadPool pool(std::min(MAX_THREADS, std::thread::hardware_concurrency()));
-    SafeVector<std::future<std::string>> futures(EXPECTED_NUMBER_OF_PACKETS);
-    std::thread writer(writerThread, std::cref(outputFileName), std::ref(futures));
+    SafeVector<PacketFuture> futures(EXPECTED_NUMBER_OF_PACKETS);
+    CaptureStats stats;
+    // readCapture() marks |futures| done on every path, including a bad magic
+    // or an unreadable file, and std::jthread joins on scope exit, so no
+    // early return can leave the writer blocked or joinable.
+    bool outputOk = true;
+    std::jthread writer(writerThread, std::cref(outputFileName), std::ref(futures), recovery.get(),
+                        std::ref(stats.decodeErrors), std::ref(outputOk));
 
     auto start = std::chrono::steady_clock::now();
-    try {
+    stats.ok = readCapture(pcapFileName, pool, futures, recoverBooks, stats.parser);
+    writer.join();
+    if (!stats.ok) {
+        return EXIT_FAILURE;
+    }
+    reportErrors(stats);
 
-        parser::PcapParser parser(pcapFileName);
-        if (!parser.readGlobalHeader()) {
+    if (recovery) {
+        recovery->Finish();
+        std::ofstream booksFile(booksFileName);
+        if (!booksFile.is_open()) {
+            std::cerr << "Error: Could not open order books output file." << std::endl;
             return EXIT_FAILURE;
         }
-        
-        // Enqueue a decoding task for each packet read.
-        for (std::vector<uint8_t> packetData; parser.readNextPacket(packetData); ) {
-            futures.push(
-                pool.enqueue([packetData]() -> std::string {
-                    simba::SimbaDecoder decoder(std::move(packetData));
-                    if (!decoder.Decode()) {
-                        return std::string{};
-                    }
-                    return decoder.GetDecodedMessages().toJSON();
-                })
-            );
-        }
-        futures.setDone();
-
-    } catch (const std::exception& ex) {
-        std::cerr << "Error: " << ex.what() << std::endl;
-        return EXIT_FAILURE;
+        recovery->WriteBooks(booksFile);
     }
 
-    writer.join();
-
     auto end = std::chrono::steady_clock::now();
-    std::cout << "Total processing time: " 
-              << std::chrono::duration<double, std::milli>(end - start).count() / 1000 
+    std::cout << "Total processing time: "
+              << std::chrono::duration<double, std::milli>(end - start).count() / 1000
               << " seconds" << std::endl;
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+    // The books are still written when the JSON output failed, but the run
+    // as a whole did not succeed.
+    return outputOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,336 @@
+#include "Batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <thread>
+#include <tuple>
+#include <fnmatch.h>
+
+void CaptureStats::add(const CaptureStats& other) {
+    parser.packets += other.parser.packets;
+    parser.malformed_packets += other.parser.malformed_packets;
+    parser.corrupt_headers += other.parser.corrupt_headers;
+    parser.resyncs += other.parser.resyncs;
+    parser.skipped_bytes += other.parser.skipped_bytes;
+    parser.truncated |= other.parser.truncated;
+    for (size_t i = 0; i < decodeErrors.size(); ++i) {
+        decodeErrors[i] += other.decodeErrors[i];
+    }
+    ok &= other.ok;
+}
+
+PacketFuture enqueueDecode(ThreadPool& pool, std::vector<uint8_t>&& packetData, uint64_t timestamp, bool keepMessages) {
+    return pool.enqueue([packetData = std::move(packetData), timestamp, keepMessages]() -> DecodedPacket {
+        simba::SimbaDecoder decoder(packetData);
+        DecodedPacket packet;
+        packet.timestamp = timestamp;
+        if (!decoder.Decode()) {
+            packet.status = decoder.GetStatus();
+            return packet;
+        }
+        packet.header = decoder.GetPacketHeader();
+        packet.json = decoder.GetDecodedMessages().toJSON();
+        if (keepMessages) {
+            packet.messages = decoder.ReleaseDecodedMessages();
+        }
+        return packet;
+    });
+}
+
+std::unique_ptr<parser::PcapParser> openCapture(const std::string& pcapFileName) {
+    try {
+        auto capture = std::make_unique<parser::PcapParser>(pcapFileName);
+        if (!capture->readGlobalHeader()) {
+            std::cerr << "Error: " << pcapFileName << " is not a supported pcap file" << std::endl;
+            return nullptr;
+        }
+        capture->enableResync(MAX_RESYNC_BYTES);
+        return capture;
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << pcapFileName << ": " << ex.what() << std::endl;
+        return nullptr;
+    }
+}
+
+bool readCapture(const std::string& pcapFileName, ThreadPool& pool, SafeVector<PacketFuture>& futures,
+                 bool keepMessages, parser::PcapParserStats& stats) {
+    bool ok = false;
+    try {
+        if (auto capture = openCapture(pcapFileName)) {
+            for (std::vector<uint8_t> packetData; capture->readNextPacket(packetData); ) {
+                futures.push(enqueueDecode(pool, std::move(packetData), capture->lastTimestamp(), keepMessages));
+            }
+            stats = capture->stats();
+            ok = true;
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << pcapFileName << ": " << ex.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Error: " << pcapFileName << ": unknown error" << std::endl;
+    }
+    futures.setDone();
+    return ok;
+}
+
+void writerThread(const std::string& outputFileName, SafeVector<PacketFuture> &futures,
+                  simba::RecoveryEngine* recovery, DecodeErrorCounts& decodeErrors, bool& outputOk) {
+    std::ofstream outFile(outputFileName);
+    if (!outFile.is_open()) {
+        std::cerr << "Error: Could not open output file " << outputFileName << std::endl;
+        outputOk = false;
+    }
+    PacketFuture future;
+    while (true) {
+        if (!futures.pop(future))  {
+            break;
+        }
+        DecodedPacket packet = future.get();
+        ++decodeErrors[static_cast<size_t>(packet.status)];
+        if (packet.json.empty()) {
+            continue;
+        }
+        if (outFile.is_open()) {
+            outFile << packet.json << "\n";
+        }
+        if (recovery) {
+            recovery->Route(packet.header, std::move(packet.messages));
+        }
+    }
+    if (outFile.is_open() && !outFile.flush()) {
+        std::cerr << "Error: Could not write output file " << outputFileName << std::endl;
+        outputOk = false;
+    }
+}
+
+bool expandInputs(const std::string& input, std::vector<std::string>& files) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+
+    if (input.starts_with("@")) {
+        std::ifstream list(input.substr(1));
+        if (!list.is_open()) {
+            std::cerr << "Error: Could not open input list " << input.substr(1) << std::endl;
+            return false;
+        }
+        for (std::string line; std::getline(list, line); ) {
+            if (!line.empty() && !expandInputs(line, files)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const fs::path path(input);
+    const std::string pattern = path.filename().string();
+    const bool isGlob = pattern.find_first_of("*?[") != std::string::npos;
+    if (!isGlob && !fs::is_directory(path, error)) {
+        files.push_back(input);
+        return true;
+    }
+
+    const fs::path directory = isGlob ? (path.has_parent_path() ? path.parent_path() : fs::path(".")) : path;
+    std::vector<std::string> matches;
+    // Entries that cannot be stat'ed, e.g. dangling symlinks, are skipped;
+    // only a failure to list the directory itself is an error.
+    error.clear();
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        std::error_code entryError;
+        if (!it->is_regular_file(entryError)) {
+            continue;
+        }
+        const std::string name = it->path().filename().string();
+        const std::string extension = it->path().extension().string();
+        if (isGlob ? fnmatch(pattern.c_str(), name.c_str(), 0) == 0 : (extension == ".pcap" || extension == ".cap")) {
+            matches.push_back(it->path().string());
+        }
+    }
+    if (error) {
+        std::cerr << "Error: Could not list " << directory << ": " << error.message() << std::endl;
+        return false;
+    }
+    // Rotated captures are named in time order.
+    std::sort(matches.begin(), matches.end());
+    files.insert(files.end(), matches.begin(), matches.end());
+    return true;
+}
+
+std::vector<std::string> batchOutputNames(const std::vector<std::string>& inputs) {
+    namespace fs = std::filesystem;
+    auto countNames = [](const std::vector<std::string>& names) {
+        std::map<std::string, size_t> counts;
+        for (const auto& name : names) {
+            ++counts[name];
+        }
+        return counts;
+    };
+
+    std::vector<std::string> names;
+    for (const auto& input : inputs) {
+        names.push_back(fs::path(input).filename().string());
+    }
+    const auto nameCounts = countNames(names);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (nameCounts.at(names[i]) > 1) {
+            const std::string parent = fs::absolute(inputs[i]).parent_path().filename().string();
+            names[i] = parent + "_" + names[i];
+        }
+    }
+    const auto prefixedCounts = countNames(names);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (prefixedCounts.at(names[i]) > 1) {
+            names[i] += "." + std::to_string(i);
+        }
+        names[i] += ".json";
+    }
+    return names;
+}
+
+CaptureStats runBatch(const std::string& outputDirectory, const std::vector<std::string>& inputs,
+                      unsigned int numThreads, unsigned int maxConcurrentFiles) {
+    std::vector<CaptureStats> stats(inputs.size());
+    std::error_code error;
+    std::filesystem::create_directories(outputDirectory, error);
+    if (error) {
+        std::cerr << "Error: Could not create " << outputDirectory << ": " << error.message() << std::endl;
+        CaptureStats failed;
+        failed.ok = false;
+        return failed;
+    }
+
+    const std::vector<std::string> outputNames = batchOutputNames(inputs);
+    ThreadPool pool(numThreads);
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> readers;
+    for (unsigned int r = 0; r < std::min<size_t>(maxConcurrentFiles, inputs.size()); ++r) {
+        readers.emplace_back([&]() {
+            for (size_t i; (i = next++) < inputs.size(); ) {
+                const std::string outputFileName = (std::filesystem::path(outputDirectory) / outputNames[i]).string();
+                SafeVector<PacketFuture> futures(EXPECTED_NUMBER_OF_PACKETS);
+                bool outputOk = true;
+                std::jthread writer(writerThread, std::cref(outputFileName), std::ref(futures), nullptr,
+                                    std::ref(stats[i].decodeErrors), std::ref(outputOk));
+                stats[i].ok = readCapture(inputs[i], pool, futures, false, stats[i].parser);
+                writer.join();
+                stats[i].ok &= outputOk;
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    CaptureStats total;
+    for (const auto& capture : stats) {
+        total.add(capture);
+    }
+    return total;
+}
+
+CaptureStats mergeCaptures(std::ostream& out, size_t count, const CaptureOpener& open, ThreadPool& pool) {
+    CaptureStats total;
+
+    // First packet timestamp of every readable capture. A capture without
+    // packets sorts first, so its error counters are still collected.
+    std::vector<std::pair<uint64_t, size_t>> starts;
+    for (size_t i = 0; i < count; ++i) {
+        auto capture = open(i);
+        if (!capture) {
+            total.ok = false;
+            continue;
+        }
+        std::vector<uint8_t> packetData;
+        starts.emplace_back(capture->readNextPacket(packetData) ? capture->lastTimestamp() : 0, i);
+    }
+    std::sort(starts.begin(), starts.end());
+
+    struct Stream {
+        std::unique_ptr<parser::PcapParser> capture;
+        std::deque<PacketFuture> pending;
+        DecodedPacket head;
+    };
+    struct Head {
+        uint64_t timestamp;
+        uint32_t msg_seq_num;
+        size_t stream;
+        bool operator>(const Head& other) const {
+            return std::tie(timestamp, msg_seq_num, stream) > std::tie(other.timestamp, other.msg_seq_num, other.stream);
+        }
+    };
+    std::vector<Stream> streams(count);
+    std::priority_queue<Head, std::vector<Head>, std::greater<>> heads;
+
+    // Tops up the read-ahead of stream |i|; closes its capture at the end.
+    auto readAhead = [&](size_t i) {
+        Stream& stream = streams[i];
+        for (std::vector<uint8_t> packetData; stream.capture && stream.pending.size() < MERGE_READ_AHEAD; ) {
+            if (!stream.capture->readNextPacket(packetData)) {
+                CaptureStats capture;
+                capture.parser = stream.capture->stats();
+                total.add(capture);
+                stream.capture.reset();
+                break;
+            }
+            stream.pending.push_back(enqueueDecode(pool, std::move(packetData), stream.capture->lastTimestamp(), false));
+        }
+    };
+    // Loads the next decodable packet of stream |i| as its head.
+    auto advance = [&](size_t i) {
+        Stream& stream = streams[i];
+        while (!stream.pending.empty()) {
+            stream.head = stream.pending.front().get();
+            stream.pending.pop_front();
+            readAhead(i);
+            ++total.decodeErrors[static_cast<size_t>(stream.head.status)];
+            if (!stream.head.json.empty()) {
+                heads.push(Head{stream.head.timestamp, stream.head.header.msg_seq_num, i});
+                return;
+            }
+        }
+        stream.head = DecodedPacket{};
+    };
+
+    size_t nextStart = 0;
+    while (true) {
+        // Open every capture whose first packet may come before the next
+        // packet out.
+        while (nextStart < starts.size() && (heads.empty() || starts[nextStart].first <= heads.top().timestamp)) {
+            const size_t i = starts[nextStart++].second;
+            streams[i].capture = open(i);
+            total.ok &= streams[i].capture != nullptr;
+            readAhead(i);
+            advance(i);
+        }
+        if (heads.empty()) {
+            break;
+        }
+        const size_t i = heads.top().stream;
+        heads.pop();
+        out << streams[i].head.json << "\n";
+        advance(i);
+    }
+    return total;
+}
+
+CaptureStats runMerge(const std::string& outputFileName, const std::vector<std::string>& inputs, unsigned int numThreads) {
+    std::ofstream outFile(outputFileName);
+    if (!outFile.is_open()) {
+        std::cerr << "Error: Could not open output file " << outputFileName << std::endl;
+        CaptureStats failed;
+        failed.ok = false;
+        return failed;
+    }
+    ThreadPool pool(numThreads);
+    CaptureStats total = mergeCaptures(outFile, inputs.size(),
+                                       [&inputs](size_t i) { return openCapture(inputs[i]); }, pool);
+    if (!outFile.flush()) {
+        std::cerr << "Error: Could not write output file " << outputFileName << std::endl;
+        total.ok = false;
+    }
+    return total;
+}
@@ -0,0 +1,103 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "PcapParser.h"
+#include "RecoveryEngine.h"
+#include "SafeVector.h"
+#include "SimbaDecoder.h"
+#include "ThreadPool.h"
+
+// Reading captures into decoding tasks and writing their output, for one
+// capture, a batch of independent captures, or several captures merged.
+
+const unsigned int EXPECTED_NUMBER_OF_PACKETS = 50000;
+// How far past a corrupt pcap record header to look for the next valid one.
+const size_t MAX_RESYNC_BYTES = 1 << 20;
+// Packets each open capture is read ahead of the merge, decoding meanwhile.
+const size_t MERGE_READ_AHEAD = 256;
+
+using DecodeErrorCounts = std::array<uint64_t, static_cast<size_t>(simba::DecodeStatus::MalformedMessage) + 1>;
+
+struct DecodedPacket {
+    simba::MarketDataPacketHeader header{};
+    simba::DecodedMessages messages;
+    std::string json;
+    // Capture timestamp in nanoseconds.
+    uint64_t timestamp = 0;
+    simba::DecodeStatus status = simba::DecodeStatus::Ok;
+};
+
+using PacketFuture = std::future<DecodedPacket>;
+
+// Per-capture results, summed up for the final report.
+struct CaptureStats {
+    parser::PcapParserStats parser;
+    DecodeErrorCounts decodeErrors{};
+    bool ok = true;
+
+    void add(const CaptureStats& other);
+};
+
+// Opens capture |index| of a merge with its global header read, or returns
+// nullptr if it cannot be read. Called twice per capture: once to find its
+// first packet, once when the merge reaches it.
+using CaptureOpener = std::function<std::unique_ptr<parser::PcapParser>(size_t index)>;
+
+PacketFuture enqueueDecode(ThreadPool& pool, std::vector<uint8_t>&& packetData, uint64_t timestamp, bool keepMessages);
+
+// Opens a capture and reads its global header, reporting why it cannot be
+// read. Returns nullptr on failure.
+std::unique_ptr<parser::PcapParser> openCapture(const std::string& pcapFileName);
+
+// Reads one capture, enqueueing a decoding task for each packet and pushing
+// its future to |futures| in capture order. |futures| is always marked done,
+// so its consumer finishes even when the capture cannot be read.
+bool readCapture(const std::string& pcapFileName, ThreadPool& pool, SafeVector<PacketFuture>& futures,
+                 bool keepMessages, parser::PcapParserStats& stats);
+
+// Writes packets in capture order and, when book recovery is enabled, hands
+// their messages to the recovery engine in the same order. |outputOk| is
+// cleared if the output file cannot be written; the futures are still
+// drained and recovery still runs.
+void writerThread(const std::string& outputFileName, SafeVector<PacketFuture>& futures,
+                  simba::RecoveryEngine* recovery, DecodeErrorCounts& decodeErrors, bool& outputOk);
+
+// Expands command line inputs into capture files. An input is a file, a
+// directory (its *.pcap and *.cap files), a glob in the last path component
+// (quoted so the shell leaves it alone), or @list with one input per line.
+bool expandInputs(const std::string& input, std::vector<std::string>& files);
+
+// Output file names for --batch: <capture name>.json, prefixed with the
+// capture's parent directory when several inputs share a name (A/day.pcap
+// and B/day.pcap become A_day.pcap.json and B_day.pcap.json), and suffixed
+// with the input index if that is still ambiguous.
+std::vector<std::string> batchOutputNames(const std::vector<std::string>& inputs);
+
+// One output file per capture. Up to |maxConcurrentFiles| captures are read
+// at once; all of them share one decoding pool.
+CaptureStats runBatch(const std::string& outputDirectory, const std::vector<std::string>& inputs,
+                      unsigned int numThreads, unsigned int maxConcurrentFiles);
+
+// Merges |count| captures into |out|, ordered by capture timestamp, then by
+// SIMBA msg_seq_num, then by capture index.
+//
+// Captures are ordered by their first packet and each one is opened only
+// once the merge reaches that packet, so rotated files of a feed are read
+// one after another and only captures overlapping in time are open at
+// once. The calling thread is the only reader; it keeps MERGE_READ_AHEAD
+// packets per open capture decoding on |pool|.
+CaptureStats mergeCaptures(std::ostream& out, size_t count, const CaptureOpener& open, ThreadPool& pool);
+
+// All captures merged into one output file; see mergeCaptures().
+CaptureStats runMerge(const std::string& outputFileName, const std::vector<std::string>& inputs, unsigned int numThreads);
+
+#endif // BATCH_H
@@ -0,0 +1,209 @@
+#include "OrderBook.h"
+
+#include <functional>
+#include <map>
+#include <sstream>
+
+namespace simba {
+
+namespace {
+
+uint32_t RptSeqOf(const std::variant<OrderUpdate, OrderExecution>& update) {
+    return std::visit([](const auto& message) { return message.rpt_seq; }, update);
+}
+
+template <typename Levels>
+void SerializeLevels(std::ostringstream& data, const Levels& levels) {
+    data << "[";
+    for (const auto& [price, size] : levels) {
+        data << "{"
+             << "\"px\":" << price * Decimal5::exponent << ","
+             << "\"size\":" << size
+             << "},";
+    }
+    if (!levels.empty()) data.seekp(-1, std::ios_base::end);
+    data << "]";
+}
+
+} // namespace
+
+void OrderBook::Clear() {
+    orders_.clear();
+}
+
+void OrderBook::Apply(const OrderBookSnapshotEntry& entry) {
+    // Entries without a price (e.g. market orders) have no level to rest on.
+    if (entry.md_entry_type == MDEntryType::EmptyBook || entry.md_entry_px.mantissa == Decimal5NULL::NULL_VALUE) {
+        return;
+    }
+    orders_[entry.md_entry_id] = Order{entry.md_entry_px.mantissa, entry.md_entry_size, entry.md_entry_type};
+}
+
+void OrderBook::Apply(const OrderUpdate& update) {
+    switch (update.md_update_action) {
+        case MDUpdateAction::New:
+        case MDUpdateAction::Change:
+            orders_[update.md_entry_id] = Order{update.md_entry_px.mantissa, update.md_entry_size, update.md_entry_type};
+            break;
+        case MDUpdateAction::Delete:
+            orders_.erase(update.md_entry_id);
+            break;
+    }
+}
+
+void OrderBook::Apply(const OrderExecution& execution) {
+    // md_entry_size carries the quantity left on the order after the trade,
+    // or is null when the exchange does not report it.
+    auto it = orders_.find(execution.md_entry_id);
+    if (it == orders_.end()) {
+        return;
+    }
+    if (execution.md_update_action == MDUpdateAction::Delete) {
+        orders_.erase(it);
+        return;
+    }
+    if (execution.md_entry_size == Int64NULL::NULL_VALUE) {
+        return;
+    }
+    if (execution.md_entry_size <= 0) {
+        orders_.erase(it);
+        return;
+    }
+    it->second.size = execution.md_entry_size;
+}
+
+std::string OrderBook::toJSON() const {
+    std::map<int64_t, int64_t, std::greater<>> bids;
+    std::map<int64_t, int64_t> offers;
+    for (const auto& [id, order] : orders_) {
+        if (order.type == MDEntryType::Bid) {
+            bids[order.price] += order.size;
+        } else if (order.type == MDEntryType::Offer) {
+            offers[order.price] += order.size;
+        }
+    }
+
+    std::ostringstream data;
+    data << "\"bids\":";
+    SerializeLevels(data, bids);
+    data << ",\"offers\":";
+    SerializeLevels(data, offers);
+    return data.str();
+}
+
+SecurityRecovery::SecurityRecovery(int32_t securityId)
+    : security_id_(securityId)
+{}
+
+void SecurityRecovery::OnSnapshotFragment(const OrderBookSnapshotWithEntries& fragment, bool last) {
+    const auto& snapshot = fragment.message;
+    if (!assembling_ || snapshot.rpt_seq != pending_rpt_seq_) {
+        assembling_ = true;
+        pending_rpt_seq_ = snapshot.rpt_seq;
+        pending_last_msg_seq_num_processed_ = snapshot.last_msg_seq_num_processed;
+        pending_entries_.clear();
+    }
+    pending_entries_.insert(pending_entries_.end(), fragment.entries.begin(), fragment.entries.end());
+    if (last) {
+        FinishSnapshot();
+    }
+}
+
+void SecurityRecovery::FinishSnapshot() {
+    if (!assembling_) {
+        return;
+    }
+    assembling_ = false;
+    CompleteSnapshot();
+}
+
+void SecurityRecovery::AbandonSnapshot() {
+    assembling_ = false;
+    pending_entries_.clear();
+}
+
+void SecurityRecovery::OnIncremental(const OrderUpdate& update) {
+    OnIncremental(Incremental{update}, update.rpt_seq);
+}
+
+void SecurityRecovery::OnIncremental(const OrderExecution& execution) {
+    OnIncremental(Incremental{execution}, execution.rpt_seq);
+}
+
+void SecurityRecovery::OnIncremental(const Incremental& update, uint32_t rptSeq) {
+    if (!synchronized_) {
+        Buffer(update);
+        return;
+    }
+    if (rptSeq <= rpt_seq_) {
+        // Already applied, e.g. the same update arriving on the other feed.
+        return;
+    }
+    if (rptSeq != rpt_seq_ + 1) {
+        synchronized_ = false;
+        ++gaps_;
+        Buffer(update);
+        return;
+    }
+    std::visit([this](const auto& message) { book_.Apply(message); }, update);
+    rpt_seq_ = rptSeq;
+}
+
+void SecurityRecovery::CompleteSnapshot() {
+    if (synchronized_ && pending_rpt_seq_ <= rpt_seq_) {
+        // The incremental stream is already ahead of this snapshot.
+        pending_entries_.clear();
+        return;
+    }
+    book_.Clear();
+    for (const auto& entry : pending_entries_) {
+        book_.Apply(entry);
+    }
+    pending_entries_.clear();
+    rpt_seq_ = pending_rpt_seq_;
+    last_msg_seq_num_processed_ = pending_last_msg_seq_num_processed_;
+    synchronized_ = true;
+    ++snapshots_applied_;
+    ReplayBuffered();
+}
+
+void SecurityRecovery::ReplayBuffered() {
+    while (!buffered_.empty()) {
+        const auto& update = buffered_.front();
+        const uint32_t rptSeq = RptSeqOf(update);
+        if (rptSeq > rpt_seq_ + 1) {
+            // Still missing updates; keep the rest for the next snapshot.
+            synchronized_ = false;
+            ++gaps_;
+            return;
+        }
+        if (rptSeq == rpt_seq_ + 1) {
+            std::visit([this](const auto& message) { book_.Apply(message); }, update);
+            rpt_seq_ = rptSeq;
+        }
+        buffered_.pop_front();
+    }
+}
+
+void SecurityRecovery::Buffer(const Incremental& update) {
+    if (buffered_.size() == MAX_BUFFERED_UPDATES) {
+        buffered_.pop_front();
+    }
+    buffered_.push_back(update);
+}
+
+std::string SecurityRecovery::toJSON() const {
+    std::ostringstream data;
+    data << "{"
+         << "\"security_id\":" << security_id_ << ","
+         << "\"synchronized\":" << (synchronized_ ? "true" : "false") << ","
+         << "\"rpt_seq\":" << rpt_seq_ << ","
+         << "\"last_msg_seq_num_processed\":" << last_msg_seq_num_processed_ << ","
+         << "\"snapshots_applied\":" << snapshots_applied_ << ","
+         << "\"gaps\":" << gaps_ << ","
+         << book_.toJSON()
+         << "}";
+    return data.str();
+}
+
+} // namespace simba
@@ -0,0 +1,99 @@
+#ifndef ORDER_BOOK_H
+#define ORDER_BOOK_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "SimbaMessages.h"
+
+namespace simba {
+
+// Order-by-order book of a single instrument.
+class OrderBook {
+public:
+    struct Order {
+        int64_t price;
+        int64_t size;
+        MDEntryType type;
+    };
+
+    void Clear();
+    void Apply(const OrderBookSnapshotEntry& entry);
+    void Apply(const OrderUpdate& update);
+    void Apply(const OrderExecution& execution);
+
+    size_t OrderCount() const { return orders_.size(); }
+
+    // Serializes the book aggregated by price level: bids best (highest)
+    // first, offers best (lowest) first.
+    std::string toJSON() const;
+
+private:
+    std::unordered_map<int64_t, Order> orders_;
+};
+
+// Rebuilds the book of one security from the snapshot channel and keeps it
+// in sync with the incremental channel by rpt_seq.
+//
+// Snapshot fragments are accumulated until the snapshot is finished, either
+// by a fragment marked last or by FinishSnapshot(). Until a complete
+// snapshot is applied, incremental updates are buffered; once it is,
+// updates newer than the snapshot's rpt_seq are replayed. A gap in rpt_seq
+// drops the book out of sync until the next snapshot.
+class SecurityRecovery {
+public:
+    // Upper bound on updates kept while waiting for a snapshot.
+    static constexpr size_t MAX_BUFFERED_UPDATES = 1 << 16;
+
+    explicit SecurityRecovery(int32_t securityId);
+
+    // A fragment with a different rpt_seq than the one being assembled
+    // starts a new snapshot.
+    void OnSnapshotFragment(const OrderBookSnapshotWithEntries& fragment, bool last);
+    // Applies the snapshot assembled so far, if any.
+    void FinishSnapshot();
+    // Drops a snapshot whose remaining fragments will never arrive.
+    void AbandonSnapshot();
+    void OnIncremental(const OrderUpdate& update);
+    void OnIncremental(const OrderExecution& execution);
+
+    int32_t SecurityId() const { return security_id_; }
+    bool IsSynchronized() const { return synchronized_; }
+    uint32_t RptSeq() const { return rpt_seq_; }
+    const OrderBook& Book() const { return book_; }
+
+    std::string toJSON() const;
+
+private:
+    using Incremental = std::variant<OrderUpdate, OrderExecution>;
+
+    void OnIncremental(const Incremental& update, uint32_t rptSeq);
+    void CompleteSnapshot();
+    void ReplayBuffered();
+    void Buffer(const Incremental& update);
+
+    int32_t security_id_;
+    OrderBook book_;
+    bool synchronized_ = false;
+    uint32_t rpt_seq_ = 0;
+    uint32_t last_msg_seq_num_processed_ = 0;
+    uint32_t snapshots_applied_ = 0;
+    uint32_t gaps_ = 0;
+
+    // Snapshot currently being assembled from fragments.
+    bool assembling_ = false;
+    uint32_t pending_rpt_seq_ = 0;
+    uint32_t pending_last_msg_seq_num_processed_ = 0;
+    std::vector<OrderBookSnapshotEntry> pending_entries_;
+
+    // Incremental updates received while the book is out of sync.
+    std::deque<Incremental> buffered_;
+};
+
+} // namespace simba
+
+#endif // ORDER_BOOK_H
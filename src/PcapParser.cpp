@@ -1,75 +1,210 @@
 #include "PcapParser.h"
 
-#include <iostream>
+#include <algorithm>
 #include <ctime>
+#include <cstring>
 
 namespace parser {
 
 PcapParser::PcapParser(const std::string& filename) {
-    file_.open(filename, std::ios::binary);
-    if (!file_.is_open()) {
+    auto file = std::make_unique<std::ifstream>(filename, std::ios::binary);
+    if (!file->is_open()) {
         throw std::runtime_error("Failed to open file");
     }
+    input_ = std::move(file);
 }
 
-PcapParser::~PcapParser() {
-    file_.close();
+PcapParser::PcapParser(std::unique_ptr<std::istream> input)
+    : input_(std::move(input))
+{
+    if (!input_) {
+        throw std::invalid_argument("PcapParser: null input stream");
+    }
 }
 
-bool PcapParser::readGlobalHeader() {
-    if (!file_.read(reinterpret_cast<char*>(&header_), sizeof(PcapGlobalHeader))) {
+PcapParser::~PcapParser() = default;
+
+bool PcapParser::readBytes(void* data, size_t size) {
+    if (!input_->read(reinterpret_cast<char*>(data), size)) {
+        position_ += input_->gcount();
         return false;
     }
+    position_ += size;
     return true;
 }
 
-bool PcapParser::readNextPacket(std::vector<uint8_t>&packetData) {
-    // Read the packet header.
-    PcapPacketHeader packetHeader;
-    if (!file_.read(reinterpret_cast<char*>(&packetHeader), sizeof(packetHeader))) {
+bool PcapParser::readGlobalHeader() {
+    if (!readBytes(&header_, sizeof(PcapGlobalHeader))) {
         return false;
     }
-    const size_t packetSize = packetHeader.incl_len;
-
-    // Ensure our internal buffer is large enough.
-    if (buffer_.size() < packetSize) {
-        buffer_.resize(packetSize);
-    }
-
-    // Read the whole packet at once.
-    if (!file_.read(reinterpret_cast<char*>(buffer_.data()), packetSize)) {
+    if (header_.magic_number == PCAP_MAGIC_MICROSECONDS) {
+        max_fraction_ = 1000000;
+    } else if (header_.magic_number == PCAP_MAGIC_NANOSECONDS) {
+        max_fraction_ = 1000000000;
+    } else {
+        // Byte-swapped or pcapng captures are not supported.
         return false;
     }
-
-    // Calculate the offset to the payload.
-    size_t offset = 0;
-    offset += ETHERNET_HEADER_SIZE;
-
-    // Read IPv4 header information.
-    const uint8_t versionAndHeaderLength = buffer_[offset];
-    const uint8_t ihl = versionAndHeaderLength & 0x0F;
-    const size_t ipHeaderSize = ihl * 4;
-    offset += IP_V4_BASE_HEADER_SIZE;
-    if (ipHeaderSize > IP_V4_BASE_HEADER_SIZE) {
-        offset += (ipHeaderSize - IP_V4_BASE_HEADER_SIZE);
+    if (header_.snaplen != 0) {
+        max_packet_size_ = std::min<size_t>(header_.snaplen, MAX_PACKET_SIZE);
     }
-    // offset += (ipHeaderSize > IP_V4_BASE_HEADER_SIZE) * (ipHeaderSize - IP_V4_BASE_HEADER_SIZE);
+    return true;
+}
+
+void PcapParser::enableResync(size_t maxSkipBytes) {
+    max_resync_bytes_ = maxSkipBytes;
+}
 
+bool PcapParser::isPlausible(const PcapPacketHeader& packetHeader) const {
+    return packetHeader.incl_len <= max_packet_size_ && packetHeader.ts_usec < max_fraction_;
+}
 
-    // Skip UDP header.
-    offset += UDP_HEADER_SIZE;
+bool PcapParser::isRecordStart(const uint8_t* data) const {
+    PcapPacketHeader candidate;
+    std::memcpy(&candidate, data, sizeof(candidate));
+    const uint8_t ipVersion = data[sizeof(candidate) + ETHERNET_HEADER_SIZE] >> 4;
+    return isPlausible(candidate) && candidate.incl_len <= candidate.orig_len &&
+           candidate.incl_len > ETHERNET_HEADER_SIZE + IP_V4_BASE_HEADER_SIZE + UDP_HEADER_SIZE &&
+           ipVersion == 4;
+}
 
-    if (offset >= packetSize) {
-        std::cerr << "Invalid Packet: not enough data" << std::endl;
+bool PcapParser::isFollowedByRecord(uint64_t start, size_t available, bool atEof, size_t candidateOffset) {
+    PcapPacketHeader candidate;
+    std::memcpy(&candidate, &buffer_[candidateOffset], sizeof(candidate));
+    const size_t next = candidateOffset + sizeof(candidate) + candidate.incl_len;
+    if (next + RECORD_START_SIZE <= available) {
+        return isRecordStart(&buffer_[next]);
+    }
+    if (atEof) {
+        // The candidate must end exactly at EOF.
+        return next == available;
+    }
+    // The following record starts past the window; read it directly. A
+    // seek past EOF also reads nothing, so compare against the stream
+    // length instead of relying on an empty read.
+    input_->seekg(0, std::ios::end);
+    const std::streamoff length = input_->tellg();
+    if (length < 0) {
+        input_->clear();
         return false;
     }
+    const uint64_t end = start + next;
+    if (end + RECORD_START_SIZE > static_cast<uint64_t>(length)) {
+        return end == static_cast<uint64_t>(length);
+    }
+    uint8_t following[RECORD_START_SIZE];
+    input_->seekg(end);
+    input_->read(reinterpret_cast<char*>(following), sizeof(following));
+    const bool complete = input_->gcount() == static_cast<std::streamsize>(sizeof(following));
+    input_->clear();
+    return complete && isRecordStart(following);
+}
 
-    // Compute payload size.
-    const size_t payloadSize = packetSize - offset;
-    packetData.resize(payloadSize);
-    std::memcpy(packetData.data(), &buffer_[offset], payloadSize);
-    return true;
+bool PcapParser::resync(uint64_t headerOffset) {
+    if (max_resync_bytes_ == 0) {
+        return false;
+    }
+    const uint64_t start = headerOffset + 1;
+    input_->clear();
+    if (!input_->seekg(start)) {
+        return false;
+    }
+    position_ = start;
+
+    const size_t window = max_resync_bytes_ + RECORD_START_SIZE;
+    if (buffer_.size() < window) {
+        buffer_.resize(window);
+    }
+    input_->read(reinterpret_cast<char*>(buffer_.data()), window);
+    const size_t available = input_->gcount();
+    const bool atEof = available < window;
+    input_->clear();
+
+    // Bytes inside a record often look like a header on their own, so a
+    // candidate is only accepted when the record it describes ends at
+    // another record start or at EOF.
+    for (size_t i = 0; i + RECORD_START_SIZE <= available && i < max_resync_bytes_; ++i) {
+        if (isRecordStart(&buffer_[i]) && isFollowedByRecord(start, available, atEof, i)) {
+            input_->seekg(start + i);
+            position_ = start + i;
+            ++stats_.resyncs;
+            stats_.skipped_bytes += position_ - headerOffset;
+            return true;
+        }
+    }
+    input_->seekg(start + available);
+    position_ = start + available;
+    stats_.skipped_bytes += available + 1;
+    return false;
+}
+
+bool PcapParser::readNextPacket(std::vector<uint8_t>&packetData) {
+    while (true) {
+        // Read the packet header.
+        const uint64_t headerOffset = position_;
+        PcapPacketHeader packetHeader;
+        if (!readBytes(&packetHeader, sizeof(packetHeader))) {
+            stats_.truncated |= input_->gcount() != 0;
+            return false;
+        }
+        if (!isPlausible(packetHeader)) {
+            // Never size buffer_ from a corrupt incl_len.
+            ++stats_.corrupt_headers;
+            if (!resync(headerOffset)) {
+                return false;
+            }
+            continue;
+        }
+        const size_t packetSize = packetHeader.incl_len;
+
+        // Ensure our internal buffer is large enough.
+        if (buffer_.size() < packetSize) {
+            buffer_.resize(packetSize);
+        }
+
+        // Read the whole packet at once.
+        if (!readBytes(buffer_.data(), packetSize)) {
+            stats_.truncated = true;
+            return false;
+        }
+        ++stats_.packets;
+
+        // Calculate the offset to the payload.
+        size_t offset = 0;
+        offset += ETHERNET_HEADER_SIZE;
+        if (offset + IP_V4_BASE_HEADER_SIZE > packetSize) {
+            ++stats_.malformed_packets;
+            continue;
+        }
+
+        // Read IPv4 header information.
+        const uint8_t versionAndHeaderLength = buffer_[offset];
+        const uint8_t ihl = versionAndHeaderLength & 0x0F;
+        const size_t ipHeaderSize = ihl * 4;
+        if (ipHeaderSize < IP_V4_BASE_HEADER_SIZE) {
+            ++stats_.malformed_packets;
+            continue;
+        }
+        offset += ipHeaderSize;
+
+        // Skip UDP header.
+        offset += UDP_HEADER_SIZE;
+
+        if (offset >= packetSize) {
+            ++stats_.malformed_packets;
+            continue;
+        }
+
+        const uint64_t fractionToNanoseconds = max_fraction_ == 1000000 ? 1000 : 1;
+        last_timestamp_ = packetHeader.ts_sec * 1000000000ull + packetHeader.ts_usec * fractionToNanoseconds;
+
+        // Compute payload size.
+        const size_t payloadSize = packetSize - offset;
+        packetData.resize(payloadSize);
+        std::memcpy(packetData.data(), &buffer_[offset], payloadSize);
+        return true;
+    }
 }
 
 
-} // namespace parser
\ No newline at end of file
+} // namespace parser
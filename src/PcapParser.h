@@ -3,9 +3,11 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include <cstdint>
 #include <stdexcept>
 #include <fstream>
+#include <istream>
 
 namespace parser {
 
@@ -13,6 +15,13 @@ constexpr size_t ETHERNET_HEADER_SIZE = 14;
 constexpr size_t UDP_HEADER_SIZE = 8;
 constexpr size_t IP_V4_BASE_HEADER_SIZE = 20;
 
+// Largest record libpcap itself will write; bounds incl_len when the global
+// header's snaplen is missing or larger.
+constexpr size_t MAX_PACKET_SIZE = 262144;
+
+constexpr uint32_t PCAP_MAGIC_MICROSECONDS = 0xa1b2c3d4;
+constexpr uint32_t PCAP_MAGIC_NANOSECONDS = 0xa1b23c4d;
+
 #pragma pack(push, 1)
 struct PcapGlobalHeader {
     uint32_t magic_number;
@@ -32,23 +41,75 @@ struct PcapPacketHeader {
 };
 #pragma pack(pop)
 
+// Counters for malformed input. Bad records are counted and skipped rather
+// than logged, so a corrupt capture costs no more than a clean one.
+struct PcapParserStats {
+    uint64_t packets = 0;
+    // Records too short for Ethernet/IPv4/UDP headers or with a bad IHL.
+    uint64_t malformed_packets = 0;
+    // Record headers with an implausible length or timestamp.
+    uint64_t corrupt_headers = 0;
+    // Successful resynchronizations and the bytes skipped to reach them.
+    uint64_t resyncs = 0;
+    uint64_t skipped_bytes = 0;
+    // Set when the capture ends in the middle of a record.
+    bool truncated = false;
+};
+
 class PcapParser {
 public:
     explicit PcapParser(const std::string& filename);
+    // Reads the capture from an arbitrary stream, e.g. an in-memory buffer.
+    explicit PcapParser(std::unique_ptr<std::istream> input);
     ~PcapParser();
 
     // Reads the global header from the PCAP file.
-    // Returns true on success, false on failure.
+    // Returns true on success, false on failure or an unsupported format.
     bool readGlobalHeader();
 
-    // Reads the next packet's data into the provided vector.
+    // On a corrupt record header, scan at most |maxSkipBytes| forward for the
+    // next plausible one instead of stopping. Disabled (0) by default.
+    void enableResync(size_t maxSkipBytes);
+
+    // Reads the next packet's data into the provided vector. Malformed
+    // records are skipped.
     // Returns true if a packet was successfully read, false otherwise.
     bool readNextPacket(std::vector<uint8_t>&packetData);
 
+    // Capture timestamp of the packet last returned by readNextPacket, in
+    // nanoseconds since the epoch regardless of the capture's resolution.
+    uint64_t lastTimestamp() const { return last_timestamp_; }
+
+    const PcapParserStats& stats() const { return stats_; }
+
 private:
-    std::ifstream file_;
-    PcapGlobalHeader header_;
+    bool readBytes(void* data, size_t size);
+    bool isPlausible(const PcapPacketHeader& packetHeader) const;
+    // Bytes isRecordStart() inspects: a record header, the Ethernet header
+    // and the first byte of the IPv4 header.
+    static constexpr size_t RECORD_START_SIZE = sizeof(PcapPacketHeader) + ETHERNET_HEADER_SIZE + 1;
+
+    // Whether |data| looks like a record header followed by an IPv4 packet
+    // large enough to carry a UDP payload.
+    bool isRecordStart(const uint8_t* data) const;
+    // Whether the candidate record at buffer_[candidateOffset] ends at
+    // another record start or at EOF. |start| is the stream offset of buffer_[0],
+    // |available| the number of bytes read into it and |atEof| whether the
+    // read stopped at the end of the stream.
+    bool isFollowedByRecord(uint64_t start, size_t available, bool atEof, size_t candidateOffset);
+    // Repositions the stream after the corrupt header read at |headerOffset|.
+    bool resync(uint64_t headerOffset);
+
+    std::unique_ptr<std::istream> input_;
+    PcapGlobalHeader header_{};
     std::vector<uint8_t>buffer_;
+    size_t max_packet_size_ = MAX_PACKET_SIZE;
+    uint32_t max_fraction_ = 1000000;
+    size_t max_resync_bytes_ = 0;
+    // Bytes consumed so far; avoids a tellg() syscall per record.
+    uint64_t position_ = 0;
+    uint64_t last_timestamp_ = 0;
+    PcapParserStats stats_;
 };
 
 } // namespace parser
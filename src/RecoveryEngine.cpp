@@ -0,0 +1,156 @@
+#include "RecoveryEngine.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace simba {
+
+namespace {
+
+int32_t SecurityIdOf(const OrderUpdate& update) { return update.security_id; }
+int32_t SecurityIdOf(const OrderExecution& execution) { return execution.security_id; }
+
+} // namespace
+
+RecoveryEngine::RecoveryEngine(size_t numShards)
+    : batches_(std::max<size_t>(numShards, 1))
+{
+    for (size_t i = 0; i < batches_.size(); ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->worker = std::thread(&RecoveryEngine::Run, std::ref(*shard));
+        shards_.push_back(std::move(shard));
+    }
+}
+
+RecoveryEngine::~RecoveryEngine() {
+    Finish();
+}
+
+size_t RecoveryEngine::ShardOf(int32_t securityId) const {
+    // Fibonacci hashing: security ids are often dense ranges, so spread them
+    // before taking the modulo.
+    const uint64_t hash = static_cast<uint32_t>(securityId) * 0x9E3779B97F4A7C15ull;
+    return (hash >> 32) % shards_.size();
+}
+
+void RecoveryEngine::Route(const MarketDataPacketHeader& header, DecodedMessages&& messages) {
+    for (const auto& update : messages.orderUpdates) {
+        batches_[ShardOf(update.security_id)].emplace_back(update);
+    }
+    for (const auto& execution : messages.orderExecutions) {
+        batches_[ShardOf(execution.security_id)].emplace_back(execution);
+    }
+    // The snapshot channel sends one instrument's book after another.
+    // LastFragment marks the packet completing the current instrument, and
+    // a fragment of another instrument (or rpt_seq) completes the previous
+    // one. StartOfSnapshot/EndOfSnapshot only delimit the whole cycle.
+    auto& snapshots = messages.orderBookSnapshots;
+    if (header.IsStartOfSnapshot() && snapshot_open_) {
+        // The previous cycle ended without the instrument's last fragment.
+        batches_[ShardOf(snapshot_security_id_)].emplace_back(SnapshotBoundary{snapshot_security_id_, false});
+        snapshot_open_ = false;
+    }
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        const auto& snapshot = snapshots[i].message;
+        if (snapshot_open_ && (snapshot.security_id != snapshot_security_id_ || snapshot.rpt_seq != snapshot_rpt_seq_)) {
+            batches_[ShardOf(snapshot_security_id_)].emplace_back(SnapshotBoundary{snapshot_security_id_, true});
+        }
+        snapshot_security_id_ = snapshot.security_id;
+        snapshot_rpt_seq_ = snapshot.rpt_seq;
+        const bool last = header.IsLastFragment() && i + 1 == snapshots.size();
+        snapshot_open_ = !last;
+        batches_[ShardOf(snapshot_security_id_)].emplace_back(SnapshotFragment{std::move(snapshots[i]), last});
+    }
+    if (header.IsEndOfSnapshot() && snapshot_open_) {
+        batches_[ShardOf(snapshot_security_id_)].emplace_back(SnapshotBoundary{snapshot_security_id_, true});
+        snapshot_open_ = false;
+    }
+
+    for (size_t i = 0; i < batches_.size(); ++i) {
+        if (!batches_[i].empty()) {
+            shards_[i]->events.push(std::move(batches_[i]));
+            batches_[i] = {};
+        }
+    }
+}
+
+void RecoveryEngine::Finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+    for (auto& shard : shards_) {
+        shard->events.setDone();
+    }
+    for (auto& shard : shards_) {
+        shard->worker.join();
+    }
+}
+
+void RecoveryEngine::WriteBooks(std::ostream& out) const {
+    std::vector<const SecurityRecovery*> securities;
+    for (const auto& shard : shards_) {
+        for (const auto& [id, security] : shard->securities) {
+            securities.push_back(&security);
+        }
+    }
+    std::sort(securities.begin(), securities.end(), [](const auto* lhs, const auto* rhs) {
+        return lhs->SecurityId() < rhs->SecurityId();
+    });
+    for (const auto* security : securities) {
+        out << security->toJSON() << "\n";
+    }
+}
+
+const SecurityRecovery* RecoveryEngine::Find(int32_t securityId) const {
+    const auto& securities = shards_[ShardOf(securityId)]->securities;
+    const auto it = securities.find(securityId);
+    return it != securities.end() ? &it->second : nullptr;
+}
+
+void RecoveryEngine::Run(Shard& shard) {
+    auto recoveryFor = [&shard](int32_t securityId) -> SecurityRecovery& {
+        return shard.securities.try_emplace(securityId, securityId).first->second;
+    };
+
+    std::vector<BookEvent> batch;
+    while (shard.events.pop(batch)) {
+        // DecodedMessages groups a packet's messages by type, which loses their
+        // interleaving on the wire. rpt_seq is increasing per instrument, so a
+        // stable sort on it restores the per-instrument order. Snapshot
+        // events keep their packet order.
+        std::stable_sort(batch.begin(), batch.end(), [](const BookEvent& lhs, const BookEvent& rhs) {
+            auto rptSeq = [](const BookEvent& event) {
+                return std::visit([](const auto& value) -> uint32_t {
+                    using T = std::decay_t<decltype(value)>;
+                    if constexpr (std::is_same_v<T, SnapshotFragment> || std::is_same_v<T, SnapshotBoundary>) {
+                        return 0;
+                    } else {
+                        return value.rpt_seq;
+                    }
+                }, event);
+            };
+            return rptSeq(lhs) < rptSeq(rhs);
+        });
+
+        for (const auto& event : batch) {
+            std::visit([&recoveryFor](const auto& value) {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, SnapshotFragment>) {
+                    recoveryFor(value.snapshot.message.security_id).OnSnapshotFragment(value.snapshot, value.last);
+                } else if constexpr (std::is_same_v<T, SnapshotBoundary>) {
+                    auto& recovery = recoveryFor(value.security_id);
+                    if (value.complete) {
+                        recovery.FinishSnapshot();
+                    } else {
+                        recovery.AbandonSnapshot();
+                    }
+                } else {
+                    recoveryFor(SecurityIdOf(value)).OnIncremental(value);
+                }
+            }, event);
+        }
+    }
+}
+
+} // namespace simba
@@ -0,0 +1,83 @@
+#ifndef RECOVERY_ENGINE_H
+#define RECOVERY_ENGINE_H
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "OrderBook.h"
+#include "SafeQueue.h"
+#include "SimbaMessages.h"
+
+namespace simba {
+
+// Rebuilds order books for every instrument seen on the snapshot and
+// incremental channels.
+//
+// Instruments are sharded across worker threads by a hash of security_id.
+// Each shard owns the SecurityRecovery state of its instruments, so book
+// state is only ever touched by one thread and needs no locking; the only
+// synchronization is the per-shard event queue.
+class RecoveryEngine {
+public:
+    explicit RecoveryEngine(size_t numShards);
+    ~RecoveryEngine();
+
+    RecoveryEngine(const RecoveryEngine&) = delete;
+    RecoveryEngine& operator=(const RecoveryEngine&) = delete;
+
+    // Routes the messages of one decoded packet to the shards owning their
+    // instruments. Must be called from a single thread, in feed order.
+    void Route(const MarketDataPacketHeader& header, DecodedMessages&& messages);
+
+    // Waits until every routed event has been applied. No more packets may
+    // be routed afterwards.
+    void Finish();
+
+    // Writes one JSON line per instrument, ordered by security_id.
+    // Only valid after Finish().
+    void WriteBooks(std::ostream& out) const;
+
+    // Recovery state of one instrument, or nullptr if it was never seen.
+    // Only valid after Finish().
+    const SecurityRecovery* Find(int32_t securityId) const;
+
+private:
+    struct SnapshotFragment {
+        OrderBookSnapshotWithEntries snapshot;
+        bool last;
+    };
+    // Ends the snapshot being assembled for an instrument: applies it when
+    // |complete|, drops it otherwise.
+    struct SnapshotBoundary {
+        int32_t security_id;
+        bool complete;
+    };
+    using BookEvent = std::variant<OrderUpdate, OrderExecution, SnapshotFragment, SnapshotBoundary>;
+
+    struct Shard {
+        SafeQueue<std::vector<BookEvent>> events;
+        std::unordered_map<int32_t, SecurityRecovery> securities;
+        std::thread worker;
+    };
+
+    size_t ShardOf(int32_t securityId) const;
+    static void Run(Shard& shard);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    // Events of the packet being routed, one batch per shard.
+    std::vector<std::vector<BookEvent>> batches_;
+    // Instrument whose snapshot is being received on the snapshot channel.
+    bool snapshot_open_ = false;
+    int32_t snapshot_security_id_ = 0;
+    uint32_t snapshot_rpt_seq_ = 0;
+    bool finished_ = false;
+};
+
+} // namespace simba
+
+#endif // RECOVERY_ENGINE_H
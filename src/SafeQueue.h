@@ -0,0 +1,46 @@
+#ifndef SAFE_QUEUE_H
+#define SAFE_QUEUE_H
+
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+
+// Same contract as SafeVector, but popped elements are released, so a
+// long-running consumer does not keep everything it has seen alive.
+template <typename T>
+class SafeQueue {
+public:
+    bool push(T&& value) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queue_.push(std::move(value));
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+    bool pop(T& value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return !queue_.empty() || done_; });
+
+        if (queue_.empty()) return false; // If empty and done flag is set
+
+        value = std::move(queue_.front());
+        queue_.pop();
+        return true;
+    }
+
+    void setDone() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ = true;
+        cv_.notify_all();
+    }
+
+private:
+    std::queue<T> queue_;
+    bool done_ = false;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+#endif // SAFE_QUEUE_H
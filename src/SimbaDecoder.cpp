@@ -1,7 +1,5 @@
 #include "SimbaDecoder.h"
 
-#include <sstream>
-
 namespace simba {
 
 SimbaDecoder::SimbaDecoder(const std::vector<uint8_t>& data)
@@ -9,73 +7,41 @@ SimbaDecoder::SimbaDecoder(const std::vector<uint8_t>& data)
 {}
 
 bool SimbaDecoder::Decode() {
-    MarketDataPacketHeader marketDataPacketHeader;
-    if (!readFromBuffer(marketDataPacketHeader)) {
+    if (!readFromBuffer(header_)) {
+        status_ = DecodeStatus::TruncatedPacketHeader;
         return false;
     }
-    if (marketDataPacketHeader.IsIncremental()) {
+    if (header_.IsIncremental()) {
         offset_ += INCREMENTAL_PACKET_HEADER_SIZE;
     }
     while (offset_ < data_.size()) {
-        SBEHeader header;
+        MessageHeader header;
         if (!readFromBuffer(header))  {
+            status_ = DecodeStatus::TruncatedMessageHeader;
             return false;
         }
-        switch (header.template_id) {
-            case OrderUpdate::TEMPLATE_ID: {        
-                if (!readFromBuffer(value_.orderUpdates.emplace_back())) {
-                    value_.orderUpdates.pop_back();
-                    return false;
-                }
-                break;
-            }
-            case OrderExecution::TEMPLATE_ID: {
-                if (!readFromBuffer(value_.orderExecutions.emplace_back())) {
-                    value_.orderExecutions.pop_back();
-                    return false;
-                }
-                break;
-            }
-            case OrderBookSnapshot::TEMPLATE_ID: {
-                OrderBookSnapshotWithEntries orderBook;
-                if (!readFromBuffer(orderBook.snapshot)) {
-                    std::cerr << "failed to read OrderBookSnapshot" << std::endl;
-                    return false;
-                }
-                orderBook.entries.resize(orderBook.snapshot.no_md_entries.num_in_group);
-                for (auto& entry : orderBook.entries) {
-                    if (!readFromBuffer(entry)) {
-                        std::cerr << "failed to read one entry of OrderBookSnapshot" << std::endl;
-                        return false;
-                    }
-                }
-                value_.orderBookSnapshots.emplace_back(orderBook);
-                break;
-            }
-            default: {
-                // Skip unknown message body bytes.
-                offset_ += header.block_length;
-                break;
-            }
+        if (!DecodeMessage(header, data_.data(), data_.size(), offset_, value_)) {
+            status_ = DecodeStatus::MalformedMessage;
+            return false;
         }
     }
     return true;
 }
 
+DecodeStatus SimbaDecoder::GetStatus() const {
+    return status_;
+}
+
 const DecodedMessages& SimbaDecoder::GetDecodedMessages() const {
     return value_;
 }
 
-std::string DecodedMessages::toJSON() const
-{
-    std::ostringstream json;
-    json << "{";
-    json << SerializeOrderUpdates(orderUpdates) << ",";
-    json << SerializeOrderExecutions(orderExecutions) <<",";
-    json << SerializeOrderBookSnapshots(orderBookSnapshots);
-    json << "}";
+DecodedMessages SimbaDecoder::ReleaseDecodedMessages() {
+    return std::move(value_);
+}
 
-    return json.str();
+const MarketDataPacketHeader& SimbaDecoder::GetPacketHeader() const {
+    return header_;
 }
 
 } // namespace simba
@@ -5,17 +5,17 @@
 #include <vector>
 #include <utility>
 #include <cstring>
-#include <iostream>
 
 #include "SimbaMessages.h"
 
 namespace simba {
 
-struct DecodedMessages {
-    std::vector<OrderUpdate> orderUpdates;
-    std::vector<OrderExecution> orderExecutions;
-    std::vector<OrderBookSnapshotWithEntries> orderBookSnapshots;
-    std::string toJSON() const;
+// Why Decode() stopped. Callers count these instead of logging per packet.
+enum class DecodeStatus : uint8_t {
+    Ok,
+    TruncatedPacketHeader,
+    TruncatedMessageHeader,
+    MalformedMessage,
 };
 
 class SimbaDecoder {
@@ -23,7 +23,11 @@ public:
     SimbaDecoder(const std::vector<uint8_t>& data);
 
     bool Decode();
+    DecodeStatus GetStatus() const;
     const DecodedMessages& GetDecodedMessages() const;
+    // Moves the decoded messages out of the decoder.
+    DecodedMessages ReleaseDecodedMessages();
+    const MarketDataPacketHeader& GetPacketHeader() const;
 
 private:
     // Template helper to read data from our buffer.
@@ -37,6 +41,8 @@ private:
     }
     const std::vector<uint8_t>& data_;
     size_t offset_;
+    MarketDataPacketHeader header_{};
+    DecodeStatus status_ = DecodeStatus::Ok;
     DecodedMessages value_;
 };
 
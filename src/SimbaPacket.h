@@ -0,0 +1,37 @@
+#ifndef SIMBA_PACKET_H
+#define SIMBA_PACKET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace simba {
+
+static constexpr size_t INCREMENTAL_PACKET_HEADER_SIZE = 12;
+
+using PacketData = std::vector<uint8_t>;
+
+#pragma pack(push, 1) // Ensures structures are packed with no padding
+
+// Market Data Packet Header structure. Precedes the SBE messages of every
+// UDP datagram and is not part of the SBE schema.
+struct MarketDataPacketHeader {
+    bool IsLastFragment() const noexcept { return msg_flags & 0x1; }
+    bool IsStartOfSnapshot() const noexcept { return msg_flags & 0x2; }
+    bool IsEndOfSnapshot() const noexcept { return msg_flags & 0x4; }
+    bool IsIncremental() const noexcept { return msg_flags & 0x8; }
+
+    uint32_t msg_seq_num;
+    uint16_t msg_size;
+    uint16_t msg_flags;
+    uint64_t sending_time;
+};
+
+static_assert(sizeof(MarketDataPacketHeader) == 16,
+            "MarketDataPacketHeader size is incorrect");
+
+#pragma pack(pop) // Restore original packing
+
+} // namespace simba
+
+#endif // SIMBA_PACKET_H
@@ -0,0 +1,121 @@
+// Tests for batch output naming and the multi-capture merge.
+// Run with `make test`.
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Batch.h"
+#include "Check.h"
+
+using namespace std::string_literals;
+
+namespace {
+
+struct TestPacket {
+    uint64_t timestamp;
+    uint32_t msgSeqNum;
+    // Written as SequenceReset.new_seq_no to identify the packet in the output.
+    uint32_t tag;
+};
+
+template <typename T>
+void Append(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// A nanosecond capture with one SIMBA packet holding a SequenceReset per
+// test packet.
+std::string Capture(const std::vector<TestPacket>& packets) {
+    std::string out;
+    Append(out, parser::PcapGlobalHeader{parser::PCAP_MAGIC_NANOSECONDS, 2, 4, 0, 0, 65535, 1});
+    for (const auto& packet : packets) {
+        std::string simba;
+        Append(simba, simba::MarketDataPacketHeader{packet.msgSeqNum, 16 + 8 + 4, 0, 0});
+        Append(simba, simba::MessageHeader{4, 2, 19780, 4});
+        Append(simba, packet.tag);
+
+        std::string data = "\x01\x00\x5e\x00\x0a\x0a\x00\x1b\x21\xc0\xff\xee\x08\x00"s;
+        data += "\x45\x00\x00\x38\x12\x34\x40\x00\x40\x11\x00\x00\x0a\x00\x00\x01\xef\xc3\x01\x0a"s;
+        data += "\x4e\x71\x4e\x71\x00\x24\x00\x00"s + simba;
+        const uint32_t size = static_cast<uint32_t>(data.size());
+        Append(out, parser::PcapPacketHeader{static_cast<uint32_t>(packet.timestamp / 1000000000),
+                                             static_cast<uint32_t>(packet.timestamp % 1000000000), size, size});
+        out += data;
+    }
+    return out;
+}
+
+// Tags of the merged output lines, in order.
+std::vector<uint32_t> Tags(const std::string& output) {
+    std::vector<uint32_t> tags;
+    const std::string key = "\"new_seq_no\":";
+    for (size_t pos = output.find(key); pos != std::string::npos; pos = output.find(key, pos + 1)) {
+        tags.push_back(static_cast<uint32_t>(std::stoul(output.substr(pos + key.size()))));
+    }
+    return tags;
+}
+
+// Merges in-memory captures. |linesAtOpen| receives, per capture, how many
+// lines had been written when the merge opened it for reading.
+std::vector<uint32_t> Merge(const std::vector<std::string>& captures, std::vector<size_t>* linesAtOpen = nullptr) {
+    std::ostringstream out;
+    std::vector<int> opens(captures.size());
+    auto open = [&](size_t i) {
+        if (++opens[i] == 2 && linesAtOpen) {
+            const std::string written = out.str();
+            (*linesAtOpen)[i] = std::count(written.begin(), written.end(), '\n');
+        }
+        auto capture = std::make_unique<parser::PcapParser>(
+            std::make_unique<std::istringstream>(captures[i], std::ios::binary));
+        CHECK(capture->readGlobalHeader());
+        return capture;
+    };
+    ThreadPool pool(2);
+    const CaptureStats stats = mergeCaptures(out, captures.size(), open, pool);
+    CHECK(stats.ok);
+    return Tags(out.str());
+}
+
+void TestBatchOutputNamesAreUnique() {
+    CHECK(batchOutputNames({"caps/a.pcap", "caps/b.pcap"}) ==
+          (std::vector<std::string>{"a.pcap.json", "b.pcap.json"}));
+    CHECK(batchOutputNames({"A/day.pcap", "B/day.pcap", "B/other.pcap"}) ==
+          (std::vector<std::string>{"A_day.pcap.json", "B_day.pcap.json", "other.pcap.json"}));
+    // Still ambiguous after the parent directory prefix.
+    CHECK(batchOutputNames({"A/day.pcap", "A/day.pcap"}) ==
+          (std::vector<std::string>{"A_day.pcap.0.json", "A_day.pcap.1.json"}));
+    CHECK(batchOutputNames({"A/day.pcap", "x/A/day.pcap", "B/day.pcap"}) ==
+          (std::vector<std::string>{"A_day.pcap.0.json", "A_day.pcap.1.json", "B_day.pcap.json"}));
+}
+
+// Interleaved captures merge by timestamp, then msg_seq_num, then capture
+// index.
+void TestMergeOrdersByTimestampSeqNumAndIndex() {
+    const std::string a = Capture({{1000, 1, 101}, {3000, 5, 102}, {5000, 6, 103}, {5000, 7, 104}});
+    const std::string b = Capture({{2000, 1, 201}, {3000, 4, 202}, {5000, 7, 203}});
+    CHECK(Merge({a, b}) == (std::vector<uint32_t>{101, 201, 202, 102, 103, 104, 203}));
+    CHECK(Merge({b, a}) == (std::vector<uint32_t>{101, 201, 202, 102, 103, 203, 104}));
+}
+
+// A rotated file is only opened once the merge reaches its first packet.
+void TestMergeOpensCaptureWhenReached() {
+    const std::string first = Capture({{1000, 1, 101}, {2000, 2, 102}, {3000, 3, 103}});
+    const std::string second = Capture({{10000, 4, 104}, {12000, 5, 105}});
+    const std::string other = Capture({{1500, 1, 201}, {11000, 2, 202}});
+    std::vector<size_t> linesAtOpen(3);
+    CHECK(Merge({first, second, other}, &linesAtOpen) == (std::vector<uint32_t>{101, 201, 102, 103, 104, 202, 105}));
+    // Each capture opens once the packets before its first one are written.
+    CHECK(linesAtOpen[0] == 0);
+    CHECK(linesAtOpen[2] == 1);
+    CHECK(linesAtOpen[1] == 4);
+}
+
+} // namespace
+
+int main() {
+    TestBatchOutputNamesAreUnique();
+    TestMergeOrdersByTimestampSeqNumAndIndex();
+    TestMergeOpensCaptureWhenReached();
+    return TestResult("BatchTest");
+}
@@ -0,0 +1,32 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <cstdlib>
+#include <iostream>
+
+// Minimal assertion helper for the standalone test programs in tests/.
+// A failed CHECK is reported and counted; the test keeps running so one
+// run shows every failure. main() returns TestResult(name).
+inline int& CheckFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                    \
+    do {                                                                                    \
+        if (!(condition)) {                                                                 \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            ++CheckFailures();                                                              \
+        }                                                                                   \
+    } while (false)
+
+inline int TestResult(const char* name) {
+    if (CheckFailures() != 0) {
+        std::cerr << name << ": " << CheckFailures() << " check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << name << ": all checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+#endif // TESTS_CHECK_H
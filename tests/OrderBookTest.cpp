@@ -0,0 +1,61 @@
+// Tests for applying snapshot entries and incremental messages to OrderBook.
+// Run with `make test`.
+#include "Check.h"
+#include "OrderBook.h"
+
+namespace {
+
+simba::OrderBookSnapshotEntry Entry(int64_t id, int64_t price, int64_t size) {
+    simba::OrderBookSnapshotEntry entry{};
+    entry.md_entry_id = id;
+    entry.md_entry_px.mantissa = price;
+    entry.md_entry_size = size;
+    entry.md_entry_type = simba::MDEntryType::Bid;
+    return entry;
+}
+
+simba::OrderExecution Execution(int64_t id, int64_t size, simba::MDUpdateAction action) {
+    simba::OrderExecution execution{};
+    execution.md_entry_id = id;
+    execution.md_entry_size = size;
+    execution.md_update_action = action;
+    execution.md_entry_type = simba::MDEntryType::Bid;
+    return execution;
+}
+
+void TestSnapshotEntryWithoutPriceIsSkipped() {
+    simba::OrderBook book;
+    book.Apply(Entry(1, 100000, 5));
+    book.Apply(Entry(2, simba::Decimal5NULL::NULL_VALUE, 3));
+    CHECK(book.OrderCount() == 1);
+    CHECK(book.toJSON() == "\"bids\":[{\"px\":1,\"size\":5}],\"offers\":[]");
+}
+
+void TestExecutionWithNullSizeKeepsOrder() {
+    simba::OrderBook book;
+    book.Apply(Entry(1, 100000, 5));
+    book.Apply(Execution(1, simba::Int64NULL::NULL_VALUE, simba::MDUpdateAction::Change));
+    CHECK(book.OrderCount() == 1);
+    CHECK(book.toJSON() == "\"bids\":[{\"px\":1,\"size\":5}],\"offers\":[]");
+}
+
+void TestExecutionUpdatesOrRemovesOrder() {
+    simba::OrderBook book;
+    book.Apply(Entry(1, 100000, 5));
+    book.Apply(Entry(2, 100000, 4));
+    book.Apply(Execution(1, 2, simba::MDUpdateAction::Change));
+    book.Apply(Execution(2, simba::Int64NULL::NULL_VALUE, simba::MDUpdateAction::Delete));
+    CHECK(book.OrderCount() == 1);
+    CHECK(book.toJSON() == "\"bids\":[{\"px\":1,\"size\":2}],\"offers\":[]");
+    book.Apply(Execution(1, 0, simba::MDUpdateAction::Change));
+    CHECK(book.OrderCount() == 0);
+}
+
+} // namespace
+
+int main() {
+    TestSnapshotEntryWithoutPriceIsSkipped();
+    TestExecutionWithNullSizeKeepsOrder();
+    TestExecutionUpdatesOrRemovesOrder();
+    return TestResult("OrderBookTest");
+}
@@ -0,0 +1,94 @@
+// Tests for PcapParser's handling of corrupt record headers.
+// Run with `make test`.
+#include <sstream>
+#include <string>
+
+#include "Check.h"
+#include "PcapParser.h"
+
+using namespace std::string_literals;
+
+namespace {
+
+constexpr size_t PAYLOAD_SIZE = 38;
+
+template <typename T>
+void Append(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// A capture of |count| UDP records whose payload starts with the record
+// index. Record |corrupt| gets an implausible incl_len and, inside its
+// payload, bytes that pass for a record header of |fakeInclLen| bytes.
+std::string Capture(int count, int corrupt, uint32_t fakeInclLen = 60) {
+    std::string out;
+    Append(out, parser::PcapGlobalHeader{parser::PCAP_MAGIC_MICROSECONDS, 2, 4, 0, 0, 65535, 1});
+    for (int i = 0; i < count; ++i) {
+        std::string data = "\x01\x00\x5e\x00\x0a\x0a\x00\x1b\x21\xc0\xff\xee\x08\x00"s;
+        data += "\x45\x00\x00\x42\x12\x34\x40\x00\x40\x11\x00\x00\x0a\x00\x00\x01\xef\xc3\x01\x0a"s;
+        data += "\x4e\x71\x4e\x71\x00\x2e\x00\x00"s;
+        std::string payload(PAYLOAD_SIZE, static_cast<char>(i));
+        if (i == corrupt) {
+            std::string fake;
+            Append(fake, parser::PcapPacketHeader{1, 0, fakeInclLen, fakeInclLen});
+            fake += std::string(parser::ETHERNET_HEADER_SIZE, '\0') + "\x45";
+            payload.replace(4, fake.size(), fake);
+        }
+        data += payload;
+        const uint32_t size = static_cast<uint32_t>(data.size());
+        const uint32_t inclLen = i == corrupt ? 0x7fffffff : size;
+        Append(out, parser::PcapPacketHeader{1700000000u + i, static_cast<uint32_t>(i), inclLen, size});
+        out += data;
+    }
+    return out;
+}
+
+// Record indices of the packets read back with the given resync window.
+std::vector<int> ReadAll(const std::string& capture, size_t maxResyncBytes) {
+    parser::PcapParser parser(std::make_unique<std::istringstream>(capture, std::ios::binary));
+    std::vector<int> indices;
+    if (!parser.readGlobalHeader()) {
+        return indices;
+    }
+    parser.enableResync(maxResyncBytes);
+    for (std::vector<uint8_t> payload; parser.readNextPacket(payload); ) {
+        indices.push_back(payload.size() == PAYLOAD_SIZE ? payload.back() : -1);
+    }
+    return indices;
+}
+
+void TestResyncSkipsHeaderLookalikeInsideCorruptRecord() {
+    CHECK(ReadAll(Capture(6, 2), 1 << 20) == (std::vector<int>{0, 1, 3, 4, 5}));
+}
+
+// The lookahead past the end of a small resync window reads from the stream.
+void TestResyncLooksAheadPastWindow() {
+    CHECK(ReadAll(Capture(6, 2), 96) == (std::vector<int>{0, 1, 3, 4, 5}));
+}
+
+// A lookalike whose record would run past EOF must not be taken for the
+// last record, whatever the window size.
+void TestResyncRejectsRecordPastEof() {
+    CHECK(ReadAll(Capture(5, 1, 5000), 1 << 20) == (std::vector<int>{0, 2, 3, 4}));
+    CHECK(ReadAll(Capture(5, 1, 5000), 96) == (std::vector<int>{0, 2, 3, 4}));
+}
+
+// The last record is followed by EOF rather than another header.
+void TestResyncAcceptsRecordEndingAtEof() {
+    CHECK(ReadAll(Capture(6, 4), 1 << 20) == (std::vector<int>{0, 1, 2, 3, 5}));
+}
+
+void TestCorruptHeaderEndsCaptureWithoutResync() {
+    CHECK(ReadAll(Capture(6, 2), 0) == (std::vector<int>{0, 1}));
+}
+
+} // namespace
+
+int main() {
+    TestResyncSkipsHeaderLookalikeInsideCorruptRecord();
+    TestResyncLooksAheadPastWindow();
+    TestResyncRejectsRecordPastEof();
+    TestResyncAcceptsRecordEndingAtEof();
+    TestCorruptHeaderEndsCaptureWithoutResync();
+    return TestResult("PcapParserTest");
+}
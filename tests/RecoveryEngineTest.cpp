@@ -0,0 +1,158 @@
+// Tests for snapshot assembly and incremental alignment in RecoveryEngine.
+// Run with `make test`.
+#include "Check.h"
+#include "RecoveryEngine.h"
+
+namespace {
+
+constexpr uint16_t LAST_FRAGMENT = 0x1;
+constexpr uint16_t START_OF_SNAPSHOT = 0x2;
+constexpr uint16_t END_OF_SNAPSHOT = 0x4;
+constexpr uint16_t INCREMENTAL = 0x8;
+
+simba::MarketDataPacketHeader Header(uint16_t flags) {
+    simba::MarketDataPacketHeader header{};
+    header.msg_flags = flags;
+    return header;
+}
+
+simba::OrderBookSnapshotEntry Entry(int64_t id, int64_t price, int64_t size, simba::MDEntryType type) {
+    simba::OrderBookSnapshotEntry entry{};
+    entry.md_entry_id = id;
+    entry.md_entry_px.mantissa = price;
+    entry.md_entry_size = size;
+    entry.md_entry_type = type;
+    return entry;
+}
+
+simba::OrderBookSnapshotWithEntries Snapshot(int32_t securityId, uint32_t rptSeq,
+                                             std::vector<simba::OrderBookSnapshotEntry> entries) {
+    simba::OrderBookSnapshotWithEntries snapshot{};
+    snapshot.message.security_id = securityId;
+    snapshot.message.rpt_seq = rptSeq;
+    snapshot.no_md_entries.block_length = sizeof(simba::OrderBookSnapshotEntry);
+    snapshot.no_md_entries.num_in_group = static_cast<uint8_t>(entries.size());
+    snapshot.entries = std::move(entries);
+    return snapshot;
+}
+
+simba::DecodedMessages Snapshots(std::vector<simba::OrderBookSnapshotWithEntries> snapshots) {
+    simba::DecodedMessages messages;
+    messages.orderBookSnapshots = std::move(snapshots);
+    return messages;
+}
+
+simba::OrderUpdate Update(int32_t securityId, uint32_t rptSeq, int64_t id, int64_t price, int64_t size,
+                          simba::MDUpdateAction action) {
+    simba::OrderUpdate update{};
+    update.security_id = securityId;
+    update.rpt_seq = rptSeq;
+    update.md_entry_id = id;
+    update.md_entry_px.mantissa = price;
+    update.md_entry_size = size;
+    update.md_update_action = action;
+    update.md_entry_type = simba::MDEntryType::Bid;
+    return update;
+}
+
+bool IsSynchronized(const simba::RecoveryEngine& engine, int32_t securityId) {
+    const auto* security = engine.Find(securityId);
+    return security && security->IsSynchronized();
+}
+
+// One snapshot cycle: security 100 spans two packets, 200 and 300 one each.
+// Every instrument's book must be rebuilt, not only the one in the packet
+// carrying EndOfSnapshot.
+void TestSnapshotCycleRebuildsEveryInstrument() {
+    using simba::MDEntryType;
+    simba::RecoveryEngine engine(3);
+    engine.Route(Header(START_OF_SNAPSHOT), Snapshots({Snapshot(100, 5, {Entry(1, 100000, 2, MDEntryType::Bid)})}));
+    engine.Route(Header(LAST_FRAGMENT), Snapshots({Snapshot(100, 5, {Entry(2, 200000, 3, MDEntryType::Offer)})}));
+    engine.Route(Header(LAST_FRAGMENT), Snapshots({Snapshot(200, 7, {Entry(3, 100000, 1, MDEntryType::Bid)})}));
+    engine.Route(Header(LAST_FRAGMENT | END_OF_SNAPSHOT),
+                 Snapshots({Snapshot(300, 9, {Entry(4, 100000, 1, MDEntryType::Offer)})}));
+    engine.Finish();
+
+    CHECK(IsSynchronized(engine, 100));
+    CHECK(IsSynchronized(engine, 200));
+    CHECK(IsSynchronized(engine, 300));
+    CHECK(engine.Find(100)->Book().OrderCount() == 2);
+    CHECK(engine.Find(100)->RptSeq() == 5);
+    CHECK(engine.Find(200)->RptSeq() == 7);
+}
+
+// A packet holding the tail of one instrument and the whole of the next:
+// the change of security_id completes the first one.
+void TestSeveralInstrumentsInOnePacket() {
+    using simba::MDEntryType;
+    simba::RecoveryEngine engine(2);
+    engine.Route(Header(START_OF_SNAPSHOT), Snapshots({Snapshot(10, 1, {Entry(1, 100000, 1, MDEntryType::Bid)})}));
+    engine.Route(Header(LAST_FRAGMENT),
+                 Snapshots({Snapshot(10, 1, {Entry(2, 100000, 1, MDEntryType::Bid)}),
+                            Snapshot(11, 3, {Entry(3, 100000, 1, MDEntryType::Bid)}),
+                            Snapshot(12, 4, {Entry(4, 100000, 1, MDEntryType::Bid)})}));
+    engine.Route(Header(END_OF_SNAPSHOT), Snapshots({}));
+    engine.Finish();
+
+    CHECK(IsSynchronized(engine, 10));
+    CHECK(IsSynchronized(engine, 11));
+    CHECK(IsSynchronized(engine, 12));
+    CHECK(engine.Find(10)->Book().OrderCount() == 2);
+}
+
+// Without LastFragment, the next instrument or EndOfSnapshot completes the
+// open one.
+void TestSnapshotFinishedByInstrumentChangeAndEndOfCycle() {
+    using simba::MDEntryType;
+    simba::RecoveryEngine engine(2);
+    engine.Route(Header(START_OF_SNAPSHOT), Snapshots({Snapshot(1, 2, {Entry(1, 100000, 1, MDEntryType::Bid)})}));
+    engine.Route(Header(0), Snapshots({Snapshot(2, 2, {Entry(2, 100000, 1, MDEntryType::Bid)})}));
+    engine.Route(Header(END_OF_SNAPSHOT), Snapshots({}));
+    engine.Finish();
+
+    CHECK(IsSynchronized(engine, 1));
+    CHECK(IsSynchronized(engine, 2));
+}
+
+// A cycle that restarts before the open instrument's last fragment drops
+// the partial snapshot instead of applying it.
+void TestRestartedCycleDropsPartialSnapshot() {
+    using simba::MDEntryType;
+    simba::RecoveryEngine engine(1);
+    engine.Route(Header(START_OF_SNAPSHOT), Snapshots({Snapshot(1, 2, {Entry(1, 100000, 1, MDEntryType::Bid)})}));
+    engine.Route(Header(START_OF_SNAPSHOT | LAST_FRAGMENT),
+                 Snapshots({Snapshot(2, 2, {Entry(2, 100000, 1, MDEntryType::Bid)})}));
+    engine.Finish();
+
+    CHECK(!IsSynchronized(engine, 1));
+    CHECK(IsSynchronized(engine, 2));
+}
+
+// Updates received before the snapshot are replayed past its rpt_seq.
+void TestBufferedUpdatesReplayedAfterSnapshot() {
+    using simba::MDEntryType;
+    using simba::MDUpdateAction;
+    simba::RecoveryEngine engine(1);
+    simba::DecodedMessages incremental;
+    incremental.orderUpdates = {Update(7, 3, 1, 100000, 1, MDUpdateAction::New),
+                                Update(7, 4, 2, 100000, 1, MDUpdateAction::New)};
+    engine.Route(Header(INCREMENTAL | LAST_FRAGMENT), std::move(incremental));
+    engine.Route(Header(START_OF_SNAPSHOT | LAST_FRAGMENT | END_OF_SNAPSHOT),
+                 Snapshots({Snapshot(7, 3, {Entry(1, 100000, 1, MDEntryType::Bid)})}));
+    engine.Finish();
+
+    CHECK(IsSynchronized(engine, 7));
+    CHECK(engine.Find(7)->RptSeq() == 4);
+    CHECK(engine.Find(7)->Book().OrderCount() == 2);
+}
+
+} // namespace
+
+int main() {
+    TestSnapshotCycleRebuildsEveryInstrument();
+    TestSeveralInstrumentsInOnePacket();
+    TestSnapshotFinishedByInstrumentChangeAndEndOfCycle();
+    TestRestartedCycleDropsPartialSnapshot();
+    TestBufferedUpdatesReplayedAfterSnapshot();
+    return TestResult("RecoveryEngineTest");
+}
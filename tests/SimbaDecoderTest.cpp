@@ -0,0 +1,196 @@
+// Tests for the generated SIMBA decoder and serializers, driven by raw SBE
+// bytes rather than the generated structs.
+// Run with `make test`.
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "SimbaDecoder.h"
+
+namespace {
+
+constexpr uint16_t SCHEMA_ID = 19780;
+constexpr uint16_t SCHEMA_VERSION = 4;
+constexpr uint16_t INCREMENTAL = 0x8;
+constexpr uint16_t LAST_FRAGMENT = 0x1;
+constexpr int64_t NULL_INT64 = 9223372036854775807;
+
+// Little-endian wire bytes of one UDP payload.
+class Packet {
+public:
+    Packet(uint32_t msgSeqNum, uint16_t msgFlags) {
+        Put<uint32_t>(msgSeqNum).Put<uint16_t>(0).Put<uint16_t>(msgFlags).Put<uint64_t>(1700000000000000000);
+        if (msgFlags & INCREMENTAL) {
+            // Incremental packet header: transact_time and trading session.
+            Put<uint64_t>(1700000000000000001).Put<uint32_t>(7);
+        }
+    }
+
+    template <typename T>
+    Packet& Put(T value) {
+        const size_t offset = bytes_.size();
+        bytes_.resize(offset + sizeof(T));
+        std::memcpy(&bytes_[offset], &value, sizeof(T));
+        return *this;
+    }
+
+    Packet& Zeros(size_t count) {
+        bytes_.resize(bytes_.size() + count);
+        return *this;
+    }
+
+    Packet& MessageHeader(uint16_t blockLength, uint16_t templateId) {
+        return Put<uint16_t>(blockLength).Put<uint16_t>(templateId).Put<uint16_t>(SCHEMA_ID).Put<uint16_t>(SCHEMA_VERSION);
+    }
+
+    Packet& OrderUpdate(int64_t id, int64_t price, int64_t size, int32_t securityId, uint32_t rptSeq,
+                        uint8_t action, char type) {
+        return MessageHeader(50, 15)
+            .Put<int64_t>(id).Put<int64_t>(price).Put<int64_t>(size)
+            .Put<uint64_t>(0x1000).Put<uint64_t>(0)
+            .Put<int32_t>(securityId).Put<uint32_t>(rptSeq).Put<uint8_t>(action).Put<char>(type);
+    }
+
+    Packet& OrderExecution(int64_t id, int64_t price, int64_t size, int64_t lastPx, int64_t lastQty,
+                           int64_t tradeId, int32_t securityId, uint32_t rptSeq, uint8_t action, char type) {
+        return MessageHeader(74, 16)
+            .Put<int64_t>(id).Put<int64_t>(price).Put<int64_t>(size)
+            .Put<int64_t>(lastPx).Put<int64_t>(lastQty).Put<int64_t>(tradeId)
+            .Put<uint64_t>(0x2000).Put<uint64_t>(0)
+            .Put<int32_t>(securityId).Put<uint32_t>(rptSeq).Put<uint8_t>(action).Put<char>(type);
+    }
+
+    // OrderBookSnapshot root block and group dimension; entries follow.
+    Packet& OrderBookSnapshot(int32_t securityId, uint32_t lastMsgSeqNum, uint32_t rptSeq,
+                              uint16_t entryBlockLength, uint8_t numInGroup) {
+        return MessageHeader(16, 17)
+            .Put<int32_t>(securityId).Put<uint32_t>(lastMsgSeqNum).Put<uint32_t>(rptSeq).Put<uint32_t>(1)
+            .Put<uint16_t>(entryBlockLength).Put<uint8_t>(numInGroup);
+    }
+
+    Packet& SnapshotEntry(int64_t id, int64_t price, int64_t size, int64_t tradeId, char type) {
+        return Put<int64_t>(id).Put<uint64_t>(1700000000000000002).Put<int64_t>(price).Put<int64_t>(size)
+            .Put<int64_t>(tradeId).Put<uint64_t>(0x1).Put<uint64_t>(0).Put<char>(type);
+    }
+
+    std::vector<uint8_t> Bytes() const {
+        std::vector<uint8_t> bytes = bytes_;
+        const uint16_t msgSize = static_cast<uint16_t>(bytes.size());
+        std::memcpy(&bytes[4], &msgSize, sizeof(msgSize));
+        return bytes;
+    }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+// Decodes |packet|; returns its JSON, or an empty string on failure.
+std::string DecodeToJSON(const Packet& packet, simba::DecodeStatus expected = simba::DecodeStatus::Ok) {
+    const std::vector<uint8_t> bytes = packet.Bytes();
+    simba::SimbaDecoder decoder(bytes);
+    const bool ok = decoder.Decode();
+    CHECK(decoder.GetStatus() == expected);
+    return ok ? decoder.GetDecodedMessages().toJSON() : "";
+}
+
+// Expected output is what the hand-written decoder produced for the same
+// bytes; a null md_entry_px is written as 0.
+void TestIncrementalMatchesBaseline() {
+    Packet packet(10, INCREMENTAL | LAST_FRAGMENT);
+    packet.OrderUpdate(1001, 12345600000, 5, 42, 3, 0, '0')
+          .OrderExecution(1002, NULL_INT64, 2, 12300000, 3, 777, 42, 4, 1, '1');
+    CHECK(DecodeToJSON(packet) ==
+          "{\"orderUpdates\":[{\"md_entry_id\":1001,\"md_entry_px\":123456,\"md_entry_size\":5,"
+          "\"md_flags\":4096,\"md_flags2\":0,\"security_id\":42,\"rpt_seq\":3,\"md_update_action\":0,"
+          "\"md_entry_type\":\"0\"}],"
+          "\"orderExecutions\":[{\"md_entry_id\":1002,\"md_entry_px\":0,\"md_entry_size\":2,"
+          "\"last_px\":123,\"last_qty\":3,\"trade_id\":777,\"md_flags\":8192,\"md_flags2\":0,"
+          "\"security_id\":42,\"rpt_seq\":4,\"md_update_action\":1,\"md_entry_type\":\"1\"}],"
+          "\"orderBookSnapshots\":[]}");
+}
+
+// Same as the baseline except md_entry_type, which is now written as its
+// character ("0") rather than its code ("48") like the other messages.
+void TestSnapshotMatchesBaseline() {
+    Packet packet(11, LAST_FRAGMENT);
+    packet.OrderBookSnapshot(42, 10, 4, 57, 3)
+          .SnapshotEntry(1, 100000, 5, 0, '0')
+          .SnapshotEntry(2, 110000, 3, 0, '0')
+          .SnapshotEntry(3, 150000, 7, 9, '1');
+    CHECK(DecodeToJSON(packet) ==
+          "{\"orderUpdates\":[],\"orderExecutions\":[],"
+          "\"orderBookSnapshots\":[{\"security_id\":42,\"last_msg_seq_num_processed\":10,\"rpt_seq\":4,"
+          "\"exchange_trading_session_id\":1,\"no_md_entries\":{\"block_length\":57,\"num_in_group\":3},"
+          "\"entries\":["
+          "{\"md_entry_id\":1,\"transact_time\":1700000000000000002,\"md_entry_px\":1,\"md_entry_size\":5,"
+          "\"trade_id\":0,\"md_flags\":1,\"md_flags2\":0,\"md_entry_type\":\"0\"},"
+          "{\"md_entry_id\":2,\"transact_time\":1700000000000000002,\"md_entry_px\":1.1,\"md_entry_size\":3,"
+          "\"trade_id\":0,\"md_flags\":1,\"md_flags2\":0,\"md_entry_type\":\"0\"},"
+          "{\"md_entry_id\":3,\"transact_time\":1700000000000000002,\"md_entry_px\":1.5,\"md_entry_size\":7,"
+          "\"trade_id\":9,\"md_flags\":1,\"md_flags2\":0,\"md_entry_type\":\"1\"}]}]}");
+}
+
+// BestPrices has an empty root block: the group dimension follows the
+// message header directly.
+void TestBestPricesWithEmptyRootBlock() {
+    Packet packet(12, INCREMENTAL | LAST_FRAGMENT);
+    packet.MessageHeader(0, 3).Put<uint16_t>(36).Put<uint8_t>(2);
+    for (int32_t securityId : {42, 43}) {
+        packet.Put<int64_t>(100000).Put<int64_t>(110000).Put<int64_t>(5).Put<int64_t>(6).Put<int32_t>(securityId);
+    }
+    packet.OrderUpdate(1, 100000, 1, 42, 1, 0, '0');
+
+    const std::vector<uint8_t> bytes = packet.Bytes();
+    simba::SimbaDecoder decoder(bytes);
+    CHECK(decoder.Decode());
+    const auto& messages = decoder.GetDecodedMessages();
+    CHECK(messages.bestPrices.size() == 1 && messages.bestPrices[0].entries.size() == 2 &&
+          messages.bestPrices[0].entries[1].security_id == 43 && messages.bestPrices[0].entries[1].mkt_offer_size == 6);
+    CHECK(messages.orderUpdates.size() == 1);
+}
+
+// Entries extended by a newer schema version advance by the block length
+// on the wire; the unknown trailing bytes are skipped.
+void TestGroupBlockLongerThanEntry() {
+    Packet packet(13, LAST_FRAGMENT);
+    packet.OrderBookSnapshot(42, 10, 4, 57 + 8, 2)
+          .SnapshotEntry(1, 100000, 5, 0, '0').Zeros(8)
+          .SnapshotEntry(2, 200000, 6, 0, '1').Zeros(8);
+
+    const std::vector<uint8_t> bytes = packet.Bytes();
+    simba::SimbaDecoder decoder(bytes);
+    CHECK(decoder.Decode());
+    const auto& snapshots = decoder.GetDecodedMessages().orderBookSnapshots;
+    CHECK(snapshots.size() == 1 && snapshots[0].entries.size() == 2);
+    if (snapshots.size() == 1 && snapshots[0].entries.size() == 2) {
+        CHECK(snapshots[0].entries[1].md_entry_id == 2);
+        CHECK(snapshots[0].entries[1].md_entry_px.mantissa == 200000);
+        CHECK(snapshots[0].entries[1].md_entry_type == simba::MDEntryType::Offer);
+    }
+}
+
+// A group count the packet cannot hold is rejected before allocating.
+void TestGroupCountLargerThanPacket() {
+    Packet packet(14, LAST_FRAGMENT);
+    packet.OrderBookSnapshot(42, 10, 4, 57, 200).SnapshotEntry(1, 100000, 5, 0, '0');
+    CHECK(DecodeToJSON(packet, simba::DecodeStatus::MalformedMessage).empty());
+}
+
+void TestGroupBlockShorterThanEntry() {
+    Packet packet(15, LAST_FRAGMENT);
+    packet.OrderBookSnapshot(42, 10, 4, 0, 1).SnapshotEntry(1, 100000, 5, 0, '0');
+    CHECK(DecodeToJSON(packet, simba::DecodeStatus::MalformedMessage).empty());
+}
+
+} // namespace
+
+int main() {
+    TestIncrementalMatchesBaseline();
+    TestSnapshotMatchesBaseline();
+    TestBestPricesWithEmptyRootBlock();
+    TestGroupBlockLongerThanEntry();
+    TestGroupCountLargerThanPacket();
+    TestGroupBlockShorterThanEntry();
+    return TestResult("SimbaDecoderTest");
+}
@@ -0,0 +1,709 @@
+#!/usr/bin/env python3
+"""Generates SimbaMessages.h / SimbaMessages.cpp from the SIMBA SBE schema.
+
+Usage: simba_codegen.py <schema.xml> <output directory>
+
+For every message in the schema the generator emits a packed struct with
+static_asserts on its size and field offsets, a JSON serializer and a case
+in the switch-based DecodeMessage() dispatcher. Messages with repeating
+groups additionally get one entry struct per group and a *WithEntries
+wrapper that owns the decoded entries.
+"""
+
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+# Messages whose lists toJSON() always writes, in this order, even when
+# empty. These are the lists the original hand-written decoder emitted and
+# downstream consumers rely on; lists of other templates are only written
+# when the packet carried such messages.
+ALWAYS_SERIALIZED = ("OrderUpdate", "OrderExecution", "OrderBookSnapshot")
+
+PRIMITIVES = {
+    "char": ("char", 1),
+    "int8": ("int8_t", 1),
+    "uint8": ("uint8_t", 1),
+    "int16": ("int16_t", 2),
+    "uint16": ("uint16_t", 2),
+    "int32": ("int32_t", 4),
+    "uint32": ("uint32_t", 4),
+    "int64": ("int64_t", 8),
+    "uint64": ("uint64_t", 8),
+    "float": ("float", 4),
+    "double": ("double", 8),
+}
+
+
+class SchemaError(Exception):
+    pass
+
+
+def local_name(tag):
+    return tag.rsplit("}", 1)[-1]
+
+
+def snake_case(name):
+    name = re.sub(r"([A-Z]+)([A-Z][a-z])", r"\1_\2", name)
+    name = re.sub(r"([a-z0-9])([A-Z])", r"\1_\2", name)
+    return name.lower()
+
+
+def pascal_case(name):
+    return name[0].upper() + name[1:]
+
+
+def camel_case(name):
+    return name[0].lower() + name[1:]
+
+
+def plural(name):
+    return name if name.endswith("s") else name + "s"
+
+
+def upper_snake(name):
+    return snake_case(name).upper()
+
+
+class Type:
+    """A schema type as seen from a message field."""
+
+    def __init__(self, name, kind, cpp, size, length=1, primitive=None,
+                 exponent=None, null_value=None, max_value=None, members=None,
+                 values=None, choices=None):
+        self.name = name
+        self.kind = kind          # primitive | enum | set | decimal | composite
+        self.cpp = cpp
+        self.size = size
+        self.length = length
+        self.primitive = primitive
+        self.exponent = exponent
+        self.null_value = null_value
+        self.max_value = max_value
+        self.members = members or []
+        self.values = values or []
+        self.choices = choices or []
+
+
+class Field:
+    def __init__(self, name, type_, offset):
+        self.name = name
+        self.member = snake_case(name)
+        self.type = type_
+        self.offset = offset
+
+
+class Block:
+    """Fixed-size root block of a message or of a group entry."""
+
+    def __init__(self, name, block_length, fields):
+        self.name = name
+        self.block_length = block_length
+        self.fields = fields
+
+
+class Group:
+    def __init__(self, name, dimension, entry, entries_member):
+        self.name = name
+        self.member = snake_case(name)
+        self.dimension = dimension
+        self.entry = entry
+        self.entries_member = entries_member
+
+
+class Message:
+    def __init__(self, name, template_id, root, groups):
+        self.name = name
+        self.template_id = template_id
+        self.root = root
+        self.groups = groups
+        self.list_member = plural(camel_case(name))
+
+    @property
+    def stored_type(self):
+        return self.name + "WithEntries" if self.groups else self.name
+
+
+def parse_primitive(element):
+    primitive = element.get("primitiveType")
+    if primitive not in PRIMITIVES:
+        raise SchemaError("unsupported primitiveType '%s' for '%s'"
+                          % (primitive, element.get("name")))
+    return primitive
+
+
+def parse_types(types_element):
+    types = {}
+    for primitive, (cpp, size) in PRIMITIVES.items():
+        types[primitive] = Type(primitive, "primitive", cpp, size,
+                                primitive=primitive)
+
+    for element in types_element:
+        tag = local_name(element.tag)
+        name = element.get("name")
+        if tag == "type":
+            primitive = parse_primitive(element)
+            cpp, size = PRIMITIVES[primitive]
+            length = int(element.get("length", "1"))
+            types[name] = Type(name, "primitive", cpp, size * length,
+                               length=length, primitive=primitive,
+                               null_value=element.get("nullValue"))
+        elif tag == "enum":
+            encoding = element.get("encodingType")
+            cpp, size = PRIMITIVES[encoding]
+            values = [(v.get("name"), v.text.strip()) for v in element]
+            types[name] = Type(name, "enum", pascal_case(name), size,
+                               primitive=encoding, values=values)
+        elif tag == "set":
+            encoding = element.get("encodingType")
+            cpp, size = PRIMITIVES[encoding]
+            choices = [(c.get("name"), int(c.text)) for c in element]
+            types[name] = Type(name, "set", cpp, size, primitive=encoding,
+                               choices=choices)
+        elif tag == "composite":
+            types[name] = parse_composite(element)
+        else:
+            raise SchemaError("unsupported type element <%s>" % tag)
+    return types
+
+
+def parse_composite(element):
+    name = element.get("name")
+    members = []
+    constants = {}
+    size = 0
+    mantissa = None
+    for member in element:
+        primitive = parse_primitive(member)
+        if member.get("presence") == "constant":
+            constants[member.get("name")] = member.text.strip()
+            continue
+        cpp, member_size = PRIMITIVES[primitive]
+        members.append((snake_case(member.get("name")), cpp, member_size))
+        size += member_size
+        if member.get("name") == "mantissa":
+            mantissa = member
+
+    if mantissa is not None and "exponent" in constants:
+        return Type(name, "decimal", pascal_case(name), size,
+                    members=members, exponent=int(constants["exponent"]),
+                    null_value=mantissa.get("nullValue"),
+                    max_value=mantissa.get("maxValue"))
+    if constants:
+        raise SchemaError("constant members are only supported in decimal "
+                          "composites ('%s')" % name)
+    return Type(name, "composite", pascal_case(name), size, members=members)
+
+
+def parse_block(name, element, block_length, types):
+    fields = []
+    offset = 0
+    for child in element:
+        if local_name(child.tag) != "field":
+            continue
+        type_name = child.get("type")
+        if type_name not in types:
+            raise SchemaError("unknown type '%s' in %s" % (type_name, name))
+        type_ = types[type_name]
+        if type_.kind == "composite":
+            raise SchemaError("composite field '%s' in %s is not supported"
+                              % (child.get("name"), name))
+        if child.get("offset") is not None and int(child.get("offset")) != offset:
+            raise SchemaError("field %s.%s declares offset %s, packed offset is %d"
+                              % (name, child.get("name"), child.get("offset"), offset))
+        fields.append(Field(child.get("name"), type_, offset))
+        offset += type_.size
+    if block_length != offset:
+        raise SchemaError("%s declares blockLength %d, fields add up to %d"
+                          % (name, block_length, offset))
+    return Block(name, block_length, fields)
+
+
+def parse_message(element, types):
+    name = element.get("name")
+    block_length = int(element.get("blockLength", "0"))
+    root = parse_block(name, element, block_length, types)
+
+    group_elements = [c for c in element if local_name(c.tag) == "group"]
+    for child in element:
+        tag = local_name(child.tag)
+        if tag == "data":
+            raise SchemaError("variable length data in %s is not supported" % name)
+        if tag == "group" and any(local_name(c.tag) == "group" for c in child):
+            raise SchemaError("nested groups in %s are not supported" % name)
+
+    groups = []
+    single = len(group_elements) == 1
+    for child in group_elements:
+        group_name = child.get("name")
+        stem = group_name[2:] if group_name.startswith("No") else group_name
+        entry_name = name + "Entry" if single else name + stem + "Entry"
+        dimension = types[child.get("dimensionType", "groupSize")]
+        entry = parse_block(entry_name, child, int(child.get("blockLength")), types)
+        entries_member = "entries" if single else snake_case(stem)
+        groups.append(Group(group_name, dimension, entry, entries_member))
+    return Message(name, int(element.get("id")), root, groups)
+
+
+def parse_schema(path):
+    root = ET.parse(path).getroot()
+    types_element = next(c for c in root if local_name(c.tag) == "types")
+    types = parse_types(types_element)
+    for required in ("messageHeader", "groupSize"):
+        if required not in types:
+            raise SchemaError("schema does not define '%s'" % required)
+    messages = [parse_message(c, types) for c in root if local_name(c.tag) == "message"]
+    names = [m.name for m in messages]
+    missing = [name for name in ALWAYS_SERIALIZED if name not in names]
+    if missing:
+        raise SchemaError("schema does not define %s" % ", ".join(missing))
+    ids = [m.template_id for m in messages]
+    if len(ids) != len(set(ids)):
+        raise SchemaError("duplicate template ids")
+    return types, messages
+
+
+# ---------------------------------------------------------------------------
+# Header generation
+# ---------------------------------------------------------------------------
+
+def enum_literal(type_, value):
+    if type_.primitive == "char":
+        return "'%s'" % value
+    return value
+
+
+def emit_type(out, type_):
+    if type_.kind == "composite":
+        out.append("struct %s {" % type_.cpp)
+        for member, cpp, _ in type_.members:
+            out.append("    %s %s;" % (cpp, member))
+        out.append("};")
+        out.append('static_assert(sizeof(%s) == %d, "%s size is incorrect");'
+                   % (type_.cpp, type_.size, type_.cpp))
+    elif type_.kind == "decimal":
+        out.append("struct %s {" % type_.cpp)
+        if type_.max_value is not None:
+            out.append("    static constexpr int64_t MAX_VALUE = %s;" % type_.max_value)
+        if type_.null_value is not None:
+            out.append("    static constexpr int64_t NULL_VALUE = %s;" % type_.null_value)
+            out.append("")
+        for member, cpp, _ in type_.members:
+            out.append("    %s %s;" % (cpp, member))
+        out.append("    static constexpr double exponent = 1e%d;" % type_.exponent)
+        out.append("};")
+        out.append('static_assert(sizeof(%s) == %d, "%s size is incorrect");'
+                   % (type_.cpp, type_.size, type_.cpp))
+    elif type_.kind == "primitive":
+        # Optional primitives stay plain integers in the message structs; the
+        # struct only carries the null sentinel, as for the decimal types.
+        suffix = "u" if type_.primitive.startswith("uint") else ""
+        out.append("struct %s {" % type_.name)
+        out.append("    static constexpr %s NULL_VALUE = %s%s;"
+                   % (type_.cpp, type_.null_value, suffix))
+        out.append("};")
+    elif type_.kind == "enum":
+        underlying = "char" if type_.primitive == "char" else PRIMITIVES[type_.primitive][0]
+        out.append("enum class %s : %s {" % (type_.cpp, underlying))
+        for name, value in type_.values:
+            out.append("    %s = %s," % (name, enum_literal(type_, value)))
+        out.append("};")
+    elif type_.kind == "set":
+        out.append("struct %s {" % pascal_case(type_.name))
+        for name, bit in type_.choices:
+            out.append("    static constexpr %s %s = %s{1} << %d;"
+                       % (type_.cpp, name, type_.cpp, bit))
+        out.append("};")
+    out.append("")
+
+
+def field_declaration(field):
+    type_ = field.type
+    if type_.kind == "primitive" and type_.length > 1:
+        return "%s %s[%d];" % (type_.cpp, field.member, type_.length)
+    return "%s %s;" % (type_.cpp, field.member)
+
+
+def emit_block(out, block, template_id=None):
+    out.append("struct %s {" % block.name)
+    if template_id is not None:
+        out.append("    static constexpr uint16_t TEMPLATE_ID = %d;" % template_id)
+    out.append("    static constexpr uint16_t BLOCK_LENGTH = %d;" % block.block_length)
+    for field in block.fields:
+        out.append("    static constexpr size_t %s_OFFSET = %d;"
+                   % (upper_snake(field.name), field.offset))
+    if block.fields:
+        out.append("")
+    for field in block.fields:
+        out.append("    " + field_declaration(field))
+    out.append("};")
+    if block.fields:
+        out.append('static_assert(sizeof(%s) == %s::BLOCK_LENGTH, "%s size is incorrect");'
+                   % (block.name, block.name, block.name))
+        for field in block.fields:
+            out.append("static_assert(offsetof(%s, %s) == %s::%s_OFFSET);"
+                       % (block.name, field.member, block.name, upper_snake(field.name)))
+    out.append("")
+
+
+def generate_header(types, messages):
+    out = [
+        "// Generated by tools/simba_codegen.py from schema/simba.xml. Do not edit.",
+        "#ifndef SIMBA_MESSAGES_H",
+        "#define SIMBA_MESSAGES_H",
+        "",
+        "#include <cstdint>",
+        "#include <cstddef>",
+        "#include <string>",
+        "#include <vector>",
+        "",
+        '#include "SimbaPacket.h"',
+        "",
+        "namespace simba {",
+        "",
+        "#pragma pack(push, 1) // Ensures structures are packed with no padding",
+        "",
+    ]
+    for type_ in types.values():
+        if type_.kind != "primitive" or type_.null_value is not None:
+            emit_type(out, type_)
+
+    for message in messages:
+        emit_block(out, message.root, message.template_id)
+        for group in message.groups:
+            emit_block(out, group.entry)
+        if message.groups:
+            out.append("struct %s {" % message.stored_type)
+            out.append("    %s message;" % message.name)
+            for group in message.groups:
+                out.append("    %s %s;" % (group.dimension.cpp, group.member))
+                out.append("    std::vector<%s> %s;" % (group.entry.name, group.entries_member))
+            out.append("};")
+            out.append("")
+
+    out += [
+        "#pragma pack(pop) // Restore original packing",
+        "",
+    ]
+    for type_ in types.values():
+        if type_.kind == "decimal":
+            out.append("double ToDouble(const %s& value);" % type_.cpp)
+    out += [
+        "",
+        "struct DecodedMessages {",
+    ]
+    for message in messages:
+        out.append("    std::vector<%s> %s;" % (message.stored_type, message.list_member))
+    out += [
+        "    std::string toJSON() const;",
+        "};",
+        "",
+        "// Decodes the body of one message whose header has already been read.",
+        "// |offset| points just past the header and is advanced past the body.",
+        "// Unknown templates are skipped by their block length.",
+        "bool DecodeMessage(const MessageHeader& header, const uint8_t* data, size_t size,",
+        "                   size_t& offset, DecodedMessages& messages);",
+        "",
+        "} // namespace simba",
+        "",
+        "#endif // SIMBA_MESSAGES_H",
+        "",
+    ]
+    return "\n".join(out)
+
+
+# ---------------------------------------------------------------------------
+# Source generation
+# ---------------------------------------------------------------------------
+
+def serialize_value(field, var):
+    type_ = field.type
+    expr = "%s.%s" % (var, field.member)
+    if type_.kind == "decimal":
+        return "ToDouble(%s)" % expr, False
+    if type_.kind == "enum":
+        if type_.primitive == "char":
+            return 'static_cast<char>(%s)' % expr, True
+        return "static_cast<int>(%s)" % expr, False
+    if type_.kind == "primitive" and type_.primitive == "char":
+        return None, True
+    if type_.primitive in ("int8", "uint8"):
+        return "static_cast<int>(%s)" % expr, False
+    return expr, False
+
+
+def emit_fields(out, block, var, separator):
+    for field in block.fields:
+        value, quoted = serialize_value(field, var)
+        if value is None:
+            out.append('    out << "%s\\"%s\\":";' % (separator, field.member))
+            out.append("    SerializeString(out, %s.%s, sizeof(%s.%s));"
+                       % (var, field.member, var, field.member))
+        elif quoted:
+            out.append('    out << "%s\\"%s\\":\\"" << %s << "\\"";'
+                       % (separator, field.member, value))
+        else:
+            out.append('    out << "%s\\"%s\\":" << %s;' % (separator, field.member, value))
+        separator = ","
+    return separator
+
+
+def emit_serializer(out, block):
+    var = "value" if block.fields else ""
+    out.append("void Serialize(std::ostream& out, const %s&%s) {" % (block.name, " " + var if var else ""))
+    out.append("    out << '{';")
+    emit_fields(out, block, var, "")
+    out.append("    out << '}';")
+    out.append("}")
+    out.append("")
+
+
+def emit_wrapper_serializer(out, message):
+    out.append("void Serialize(std::ostream& out, const %s& value) {" % message.stored_type)
+    out.append("    out << '{';")
+    separator = emit_fields(out, message.root, "value.message", "")
+    for group in message.groups:
+        out.append('    out << "%s\\"%s\\":{\\"block_length\\":" << value.%s.block_length'
+                   % (separator, group.member, group.member))
+        out.append('        << ",\\"num_in_group\\":" << static_cast<int>(value.%s.num_in_group) << "},";'
+                   % group.member)
+        out.append('    SerializeList(out, "%s", value.%s);' % (group.entries_member, group.entries_member))
+        separator = ","
+    out.append("    out << '}';")
+    out.append("}")
+    out.append("")
+
+
+def emit_decode_case(out, message):
+    target = "messages.%s" % message.list_member
+    out.append("        case %s::TEMPLATE_ID: {" % message.name)
+    if not message.groups:
+        if message.root.fields:
+            out.append("            if (!ReadBlock(data, size, offset, header.block_length, %s.emplace_back())) {" % target)
+            out.append("                %s.pop_back();" % target)
+            out.append("                return false;")
+            out.append("            }")
+        else:
+            out.append("            if (!SkipBlock(size, offset, header.block_length)) {")
+            out.append("                return false;")
+            out.append("            }")
+            out.append("            %s.emplace_back();" % target)
+        out.append("            return true;")
+        out.append("        }")
+        return
+
+    out.append("            %s value;" % message.stored_type)
+    if message.root.fields:
+        out.append("            if (!ReadBlock(data, size, offset, header.block_length, value.message)) {")
+    else:
+        out.append("            if (!SkipBlock(size, offset, header.block_length)) {")
+    out.append("                return false;")
+    out.append("            }")
+    for group in message.groups:
+        out.append("            if (!ReadGroup(data, size, offset, value.%s, value.%s)) {"
+                   % (group.member, group.entries_member))
+        out.append("                return false;")
+        out.append("            }")
+    out.append("            %s.push_back(std::move(value));" % target)
+    out.append("            return true;")
+    out.append("        }")
+
+
+SOURCE_HELPERS = """\
+namespace {
+
+// Copies one fixed-size block. Blocks longer than the struct (newer schema
+// versions appending fields) are accepted and the tail is skipped.
+template <typename T>
+bool ReadBlock(const uint8_t* data, size_t size, size_t& offset, uint16_t blockLength, T& value) {
+    if (blockLength < sizeof(T) || offset + blockLength > size)
+        return false;
+    std::memcpy(&value, data + offset, sizeof(T));
+    offset += blockLength;
+    return true;
+}
+
+bool SkipBlock(size_t size, size_t& offset, uint16_t blockLength) {
+    if (offset + blockLength > size)
+        return false;
+    offset += blockLength;
+    return true;
+}
+
+template <typename Dimension, typename T>
+bool ReadGroup(const uint8_t* data, size_t size, size_t& offset, Dimension& dimension, std::vector<T>& entries) {
+    if (offset + sizeof(Dimension) > size)
+        return false;
+    std::memcpy(&dimension, data + offset, sizeof(Dimension));
+    offset += sizeof(Dimension);
+    // Reject counts the packet cannot hold before allocating for them.
+    if (sizeof(T) > dimension.block_length ||
+        dimension.num_in_group > (size - offset) / dimension.block_length)
+        return false;
+    entries.resize(dimension.num_in_group);
+    for (auto& entry : entries) {
+        if (!ReadBlock(data, size, offset, dimension.block_length, entry))
+            return false;
+    }
+    return true;
+}
+
+// Writes a fixed-length, NUL padded char array as a JSON string.
+void SerializeString(std::ostream& out, const char* value, size_t length) {
+    out << '"';
+    for (size_t i = 0; i < length && value[i] != '\\0'; ++i) {
+        const char c = value[i];
+        if (c == '"' || c == '\\\\') {
+            out << '\\\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+"""
+
+
+def generate_source(types, messages):
+    out = [
+        "// Generated by tools/simba_codegen.py from schema/simba.xml. Do not edit.",
+        '#include "SimbaMessages.h"',
+        "",
+        "#include <cstring>",
+        "#include <ostream>",
+        "#include <sstream>",
+        "",
+        "namespace simba {",
+        "",
+    ]
+    for type_ in types.values():
+        if type_.kind != "decimal":
+            continue
+        out.append("double ToDouble(const %s& value) {" % type_.cpp)
+        if type_.null_value is not None:
+            out.append("    return (value.mantissa != %s::NULL_VALUE? value.mantissa * %s::exponent: 0);"
+                       % (type_.cpp, type_.cpp))
+        else:
+            out.append("    return value.mantissa * %s::exponent;" % type_.cpp)
+        out.append("}")
+        out.append("")
+
+    out.append(SOURCE_HELPERS.rstrip("\n"))
+    out.append("")
+    # Roots of messages with groups are serialized inline by their wrapper.
+    blocks = []
+    for message in messages:
+        if not message.groups:
+            blocks.append(message.root)
+        blocks.extend(group.entry for group in message.groups)
+    for block in blocks:
+        out.append("void Serialize(std::ostream& out, const %s& value);" % block.name)
+    for message in messages:
+        if message.groups:
+            out.append("void Serialize(std::ostream& out, const %s& value);" % message.stored_type)
+    out.append("")
+    out += [
+        "template <typename T>",
+        "void SerializeList(std::ostream& out, const char* name, const std::vector<T>& values) {",
+        '    out << \'"\' << name << "\\":[";',
+        "    for (size_t i = 0; i < values.size(); ++i) {",
+        "        if (i != 0)",
+        "            out << ',';",
+        "        Serialize(out, values[i]);",
+        "    }",
+        "    out << ']';",
+        "}",
+        "",
+    ]
+    for block in blocks:
+        emit_serializer(out, block)
+    for message in messages:
+        if message.groups:
+            emit_wrapper_serializer(out, message)
+    out += [
+        "} // namespace",
+        "",
+        "bool DecodeMessage(const MessageHeader& header, const uint8_t* data, size_t size,",
+        "                   size_t& offset, DecodedMessages& messages) {",
+        "    switch (header.template_id) {",
+    ]
+    for message in messages:
+        emit_decode_case(out, message)
+    out += [
+        "        default: {",
+        "            // Skip unknown message body bytes.",
+        "            return SkipBlock(size, offset, header.block_length);",
+        "        }",
+        "    }",
+        "}",
+        "",
+        "std::string DecodedMessages::toJSON() const",
+        "{",
+        "    std::ostringstream json;",
+        '    json << "{";',
+        "    bool first = true;",
+    ]
+    by_name = {message.name: message for message in messages}
+    for name in ALWAYS_SERIALIZED:
+        message = by_name[name]
+        out += [
+            "    if (!first)",
+            "        json << ',';",
+            '    SerializeList(json, "%s", %s);' % (message.list_member, message.list_member),
+            "    first = false;",
+        ]
+    for message in messages:
+        if message.name in ALWAYS_SERIALIZED:
+            continue
+        out += [
+            "    if (!%s.empty()) {" % message.list_member,
+            "        if (!first)",
+            "            json << ',';",
+            '        SerializeList(json, "%s", %s);' % (message.list_member, message.list_member),
+            "        first = false;",
+            "    }",
+        ]
+    out += [
+        '    json << "}";',
+        "",
+        "    return json.str();",
+        "}",
+        "",
+        "} // namespace simba",
+        "",
+    ]
+    return "\n".join(out)
+
+
+def write_if_changed(path, content):
+    if os.path.exists(path):
+        with open(path) as existing:
+            if existing.read() == content:
+                # Still bump the timestamp so make sees the target as fresh.
+                os.utime(path)
+                return
+    with open(path, "w") as output:
+        output.write(content)
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.stderr.write("Usage: %s <schema.xml> <output directory>\n" % argv[0])
+        return 1
+    try:
+        types, messages = parse_schema(argv[1])
+    except (SchemaError, ET.ParseError) as error:
+        sys.stderr.write("%s: %s\n" % (argv[1], error))
+        return 1
+    os.makedirs(argv[2], exist_ok=True)
+    write_if_changed(os.path.join(argv[2], "SimbaMessages.h"), generate_header(types, messages))
+    write_if_changed(os.path.join(argv[2], "SimbaMessages.cpp"), generate_source(types, messages))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))